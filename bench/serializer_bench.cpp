@@ -0,0 +1,368 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include <jogasaki/serializer/base128v.h>
+#include <jogasaki/serializer/details/decimal_coefficient.h>
+#include <jogasaki/serializer/value_input.h>
+#include <jogasaki/serializer/value_output.h>
+
+// micro-benchmarks of the value serializer, each decoding function compared
+// with the byte-at-a-time implementation it replaced
+namespace jogasaki::serializer::bench {
+
+namespace {
+
+constexpr std::size_t values_per_buffer = 4096;
+
+// kept out of line to be called as the library functions are
+namespace scalar {
+
+[[gnu::noinline]] std::optional<std::uint64_t> read_unsigned(buffer_view::const_iterator& iterator, buffer_view::const_iterator end) noexcept {
+    std::uint64_t result {};
+    auto iter_work = iterator;
+    for (std::uint64_t i = 0; i < 8; ++i) {
+        if (iter_work == end) {
+            return std::nullopt;
+        }
+        auto group = static_cast<std::uint64_t>(static_cast<unsigned char>(*iter_work));
+        if (group == 0 && i != 0) {
+            return std::nullopt;
+        }
+        ++iter_work;
+        result |= (group & 0x7fULL) << (i * 7);
+        if ((group & 0x80ULL) == 0) {
+            iterator = iter_work;
+            return { result };
+        }
+    }
+    if (iter_work == end) {
+        return std::nullopt;
+    }
+    auto group = static_cast<std::uint64_t>(static_cast<unsigned char>(*iter_work));
+    if (group == 0) {
+        return std::nullopt;
+    }
+    ++iter_work;
+    result |= (group & 0xffULL) << 56ULL;
+    iterator = iter_work;
+    return { result };
+}
+
+[[gnu::noinline]] double read_float8(buffer_view::const_iterator& position, buffer_view::const_iterator end) {
+    if (peek_type(position, end) != entry_type::float8 || std::distance(position, end) < 9) {
+        throw std::runtime_error("float8 expected");
+    }
+    ++position;
+    std::uint64_t bits { 0 };
+    for (std::size_t i = 1; i <= sizeof(bits); ++i) {
+        std::uint64_t value { static_cast<unsigned char>(*position) };
+        bits |= value << ((sizeof(bits) - i) * 8U);
+        ++position;
+    }
+    double result {};
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// boost reports its own limbs maybe uninitialized when optimized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+[[gnu::noinline]] std::size_t encode_decimal(const takatori::decimal::triple& triple, std::array<std::uint8_t, 17>& out) {
+    boost::multiprecision::cpp_int v = triple.coefficient_high();
+    v <<= sizeof(std::uint64_t) * 8;
+    v |= triple.coefficient_low();
+    if (triple.sign() < 0) {
+        v *= -1;
+    }
+    boost::multiprecision::cpp_int mask = UINT8_MAX;
+    for (std::size_t i = 0; i < out.size(); i++) {
+        out.at((out.size() - 1) - i) = static_cast<std::uint8_t>((v >> (i * 8)) & mask);
+    }
+    std::size_t skip = 0;
+    for (std::size_t i = 0; i < (out.size() - 1); i++) {
+        if ((triple.sign() > 0 && (out.at(i) == 0)) || (triple.sign() < 0 && (out.at(i) == UINT8_MAX))) {
+            skip++;
+            continue;
+        }
+        break;
+    }
+    constexpr std::uint8_t sign = static_cast<std::uint8_t>(1) << ((sizeof(std::uint8_t) * 8) - 1);
+    if (((triple.sign() > 0) && ((out.at(skip) & sign) != 0))
+        || ((triple.sign() < 0) && ((out.at(skip) & sign) != sign))) {
+        skip--;
+    }
+    return out.size() - skip;
+}
+#pragma GCC diagnostic pop
+
+}  // namespace scalar
+
+/**
+ * @brief varints of values below 2^bits, written back to back.
+ *  The values are of random widths if bits is 0.
+ */
+std::vector<char> varints(std::size_t bits) {
+    std::mt19937_64 engine{bits};
+    std::vector<char> buffer(values_per_buffer * 9);
+    buffer_view view{buffer.data(), buffer.size()};
+    auto iter = view.begin();
+    for (std::size_t i = 0; i < values_per_buffer; i++) {
+        auto width = bits != 0 ? bits : engine() % 64 + 1;
+        auto value = width >= 64 ? engine() : engine() & ((1ULL << width) - 1U);
+        base128v::write_unsigned(value, iter, view.end());
+    }
+    buffer.resize(std::distance(view.begin(), iter));
+    return buffer;
+}
+
+/**
+ * @brief varints are decoded one after another.
+ * @param range(0) the number of significant bits of the values
+ * @param range(1) 1 to decode by the current function, 0 by the byte-at-a-time one
+ */
+void read_unsigned(benchmark::State& state) {
+    auto buffer = varints(static_cast<std::size_t>(state.range(0)));
+    bool current = state.range(1) != 0;
+
+    // both must agree before they are compared
+    {
+        buffer_view::const_iterator a = buffer.data();
+        buffer_view::const_iterator b = buffer.data();
+        auto end = buffer.data() + buffer.size();
+        while (a != end) {
+            if (base128v::read_unsigned(a, end) != scalar::read_unsigned(b, end) || a != b) {
+                state.SkipWithError("decoded values differ");
+                return;
+            }
+        }
+    }
+
+    for (auto _ : state) {
+        buffer_view::const_iterator iter = buffer.data();
+        auto end = buffer.data() + buffer.size();
+        std::uint64_t sum{};
+        while (iter != end) {
+            sum += current ? *base128v::read_unsigned(iter, end) : *scalar::read_unsigned(iter, end);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * values_per_buffer));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * buffer.size()));
+}
+
+/**
+ * @brief float8 entries are decoded one after another.
+ * @param range(0) 1 to decode by the current function, 0 by the byte-at-a-time one
+ */
+void read_float8(benchmark::State& state) {
+    bool current = state.range(0) != 0;
+    std::vector<char> buffer(values_per_buffer * 9);
+    buffer_view view{buffer.data(), buffer.size()};
+    auto out = view.begin();
+    for (std::size_t i = 0; i < values_per_buffer; i++) {
+        write_float8(static_cast<double>(i) / 3.0, out, view.end());
+    }
+
+    for (auto _ : state) {
+        buffer_view::const_iterator iter = buffer.data();
+        auto end = buffer.data() + buffer.size();
+        double sum{};
+        for (std::size_t i = 0; i < values_per_buffer; i++) {
+            sum += current ? serializer::read_float8(iter, end) : scalar::read_float8(iter, end);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * values_per_buffer));
+}
+
+/**
+ * @brief int entries, as an INT8 column has, are decoded one after another.
+ * @param range(0) the number of significant bits of the values
+ */
+void read_int(benchmark::State& state) {
+    std::mt19937_64 engine{};
+    auto bits = static_cast<std::size_t>(state.range(0));
+    std::vector<char> buffer(values_per_buffer * 10);
+    buffer_view view{buffer.data(), buffer.size()};
+    auto out = view.begin();
+    for (std::size_t i = 0; i < values_per_buffer; i++) {
+        auto value = static_cast<std::int64_t>(engine() & ((1ULL << bits) - 1U));
+        write_int(value, out, view.end());
+    }
+    auto end = out;
+
+    for (auto _ : state) {
+        buffer_view::const_iterator iter = buffer.data();
+        std::int64_t sum{};
+        while (iter != end) {
+            sum += serializer::read_int(iter, end);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * values_per_buffer));
+}
+
+/**
+ * @brief a run of int entries, as consecutive INT8 columns have, is decoded by a call or one by one.
+ * @param range(0) the number of entries in a run
+ * @param range(1) 1 to decode by read_ints(), 0 by read_int()
+ */
+void read_ints(benchmark::State& state) {
+    auto run = static_cast<std::size_t>(state.range(0));
+    bool batch = state.range(1) != 0;
+    std::mt19937_64 engine{};
+    std::vector<char> buffer(values_per_buffer * 10);
+    buffer_view view{buffer.data(), buffer.size()};
+    auto out = view.begin();
+    for (std::size_t i = 0; i < values_per_buffer; i++) {
+        write_int(static_cast<std::int64_t>(engine() & 0xffffU), out, view.end());
+    }
+    auto end = out;
+    std::vector<std::int64_t> values(run);
+
+    for (auto _ : state) {
+        buffer_view::const_iterator iter = buffer.data();
+        for (std::size_t i = 0; i + run <= values_per_buffer; i += run) {
+            if (batch) {
+                serializer::read_ints(iter, end, values.data(), run);
+            } else {
+                for (std::size_t j = 0; j < run; j++) {
+                    values[j] = serializer::read_int(iter, end);
+                }
+            }
+            benchmark::DoNotOptimize(values.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * (values_per_buffer / run * run)));
+}
+
+/**
+ * @brief a run of float8 entries, as consecutive FLOAT8 columns have, is decoded by a call or one by one.
+ * @param range(0) the number of entries in a run
+ * @param range(1) 1 to decode by read_float8s(), 0 by read_float8()
+ */
+void read_float8s(benchmark::State& state) {
+    auto run = static_cast<std::size_t>(state.range(0));
+    bool batch = state.range(1) != 0;
+    std::vector<char> buffer(values_per_buffer * 9);
+    buffer_view view{buffer.data(), buffer.size()};
+    auto out = view.begin();
+    for (std::size_t i = 0; i < values_per_buffer; i++) {
+        write_float8(static_cast<double>(i) / 3.0, out, view.end());
+    }
+    auto end = out;
+    std::vector<double> values(run);
+
+    for (auto _ : state) {
+        buffer_view::const_iterator iter = buffer.data();
+        for (std::size_t i = 0; i + run <= values_per_buffer; i += run) {
+            if (batch) {
+                serializer::read_float8s(iter, end, values.data(), run);
+            } else {
+                for (std::size_t j = 0; j < run; j++) {
+                    values[j] = serializer::read_float8(iter, end);
+                }
+            }
+            benchmark::DoNotOptimize(values.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * (values_per_buffer / run * run)));
+}
+
+/**
+ * @brief decimals with coefficients below 2^bits, in both signs.
+ */
+std::vector<takatori::decimal::triple> decimals(std::size_t bits) {
+    std::mt19937_64 engine{bits};
+    std::vector<takatori::decimal::triple> values{};
+    values.reserve(values_per_buffer);
+    for (std::size_t i = 0; i < values_per_buffer; i++) {
+        std::uint64_t high = bits > 64 ? engine() & ((1ULL << (bits - 64)) - 1U) : 0;
+        std::uint64_t low = bits >= 64 ? engine() : engine() & ((1ULL << bits) - 1U);
+        values.emplace_back((i % 2) == 0 ? +1 : -1, high, low, -2);
+    }
+    return values;
+}
+
+/**
+ * @brief decimals are encoded into the coefficient octets, as decimal parameters are.
+ * @param range(0) the number of significant bits of the coefficients
+ * @param range(1) 1 to encode by the current function, 0 by the multi-precision one
+ */
+void encode_decimal(benchmark::State& state) {
+    auto values = decimals(static_cast<std::size_t>(state.range(0)));
+    bool current = state.range(1) != 0;
+    details::decimal_coefficient_buffer buffer{};
+    std::array<std::uint8_t, details::max_decimal_coefficient_size> octets{};
+
+    for (auto _ : state) {
+        std::size_t total{};
+        for (auto&& value : values) {
+            total += current ? details::encode_decimal_coefficient(value, buffer).size() : scalar::encode_decimal(value, octets);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * values_per_buffer));
+}
+
+/**
+ * @brief decimal entries, as a DECIMAL column has, are decoded one after another.
+ * @param range(0) the number of significant bits of the coefficients
+ */
+void read_decimal(benchmark::State& state) {
+    auto values = decimals(static_cast<std::size_t>(state.range(0)));
+    std::vector<char> buffer(values_per_buffer * 32);
+    buffer_view view{buffer.data(), buffer.size()};
+    auto out = view.begin();
+    for (auto&& value : values) {
+        write_decimal(value, out, view.end());
+    }
+    auto end = out;
+
+    for (auto _ : state) {
+        buffer_view::const_iterator iter = buffer.data();
+        std::uint64_t sum{};
+        while (iter != end) {
+            sum += serializer::read_decimal(iter, end).coefficient_low();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * values_per_buffer));
+}
+
+}  // namespace
+
+BENCHMARK(read_unsigned)->ArgNames({"bits", "current"})->ArgsProduct({{7, 14, 28, 56, 64, 0}, {0, 1}});
+BENCHMARK(read_float8)->ArgNames({"current"})->Arg(0)->Arg(1);
+BENCHMARK(read_int)->ArgNames({"bits"})->Arg(6)->Arg(16)->Arg(32)->Arg(62);
+BENCHMARK(read_ints)->ArgNames({"run", "batch"})->ArgsProduct({{4, 16, 64}, {0, 1}});
+BENCHMARK(read_float8s)->ArgNames({"run", "batch"})->ArgsProduct({{4, 16, 64}, {0, 1}});
+BENCHMARK(encode_decimal)->ArgNames({"bits", "current"})->ArgsProduct({{32, 96, 128}, {0, 1}});
+BENCHMARK(read_decimal)->ArgNames({"bits"})->Arg(96)->Arg(128);
+
+}  // namespace jogasaki::serializer::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "stub_test_root.h"
+
+// end-to-end benchmarks of the stub against the test server,
+// which streams synthetic result sets and answers requests with canned responses
+namespace ogawayama::testing {
+
+namespace {
+
+using jogasaki::proto::sql::common::AtomType;
+
+constexpr std::size_t rows_per_query = 4096;
+
+/**
+ * @brief the test server and a connection to it, with the given number of transactions begun.
+ */
+class session {
+public:
+    explicit session(const boost::property_tree::ptree& option = {}, std::size_t transactions = 1)
+        : name_("stub_bench" + std::to_string(getpid())), server_(std::make_unique<server>(name_)) {
+        if (make_stub(stub_, name_) != ERROR_CODE::OK || stub_->get_connection(connection_, 16, option) != ERROR_CODE::OK) {
+            throw std::runtime_error("cannot connect to the test server");
+        }
+        for (std::size_t i = 0; i < transactions; i++) {
+            jogasaki::proto::sql::response::Begin b{};
+            auto* s = b.mutable_success();
+            s->mutable_transaction_handle()->set_handle(i + 1);
+            s->mutable_transaction_id()->set_id("transaction_id_for_bench");
+            server_->response_message(b);
+            if (connection_->begin(transactions_.emplace_back()) != ERROR_CODE::OK) {
+                throw std::runtime_error("cannot begin a transaction");
+            }
+        }
+    }
+    ~session() {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        for (auto&& transaction : transactions_) {
+            server_->response_message(ro);
+            server_->response_message(ro);
+            (void) transaction->commit();
+        }
+    }
+
+    session(session const&) = delete;
+    session(session&&) = delete;
+    session& operator = (session const&) = delete;
+    session& operator = (session&&) = delete;
+
+    [[nodiscard]] server& get_server() noexcept {
+        return *server_;
+    }
+    [[nodiscard]] ogawayama::stub::Transaction& transaction(std::size_t index = 0) {
+        return *transactions_.at(index);
+    }
+
+private:
+    std::string name_;
+    std::unique_ptr<server> server_;
+    StubPtr stub_{};
+    ConnectionPtr connection_{};
+    std::vector<TransactionPtr> transactions_{};
+};
+
+/**
+ * @brief rows of the columns of a type are read by ResultSet::next() and next_column().
+ * @param range(0) the number of columns
+ * @param range(1) the percentage of NULL values
+ * @param range(2) the length of CHARACTER values
+ */
+template <typename T, AtomType Type>
+void decode(benchmark::State& state) {
+    auto columns = static_cast<std::size_t>(state.range(0));
+    synthetic_column column{Type, static_cast<double>(state.range(1)) / 100.0, static_cast<std::size_t>(state.range(2))};
+
+    session s{};
+    synthetic_resultset resultset{std::vector<synthetic_column>(columns, column), rows_per_query};
+    ResultSetPtr result_set{};
+    auto query = [&s, &resultset, &result_set]() {
+        result_set = nullptr;
+        resultset.rewind();
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        s.get_server().response_with_resultset(resultset, ro);
+        return s.transaction().execute_query("SELECT * FROM T", result_set) == ERROR_CODE::OK;
+    };
+    if (!query()) {
+        state.SkipWithError("execute_query failed");
+        return;
+    }
+
+    T value{};
+    for (auto _ : state) {
+        if (result_set->next() != ERROR_CODE::OK) {
+            state.PauseTiming();
+            if (!query() || result_set->next() != ERROR_CODE::OK) {
+                state.SkipWithError("execute_query failed");
+                break;
+            }
+            state.ResumeTiming();
+        }
+        for (std::size_t i = 0; i < columns; i++) {
+            benchmark::DoNotOptimize(result_set->next_column(value));
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    result_set = nullptr;
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["column_time"] = benchmark::Counter(static_cast<double>(state.iterations() * columns), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+/**
+ * @brief rows of the columns of a type are read by ResultSet::next_batch().
+ * @param range(0) the number of columns
+ * @param range(1) the percentage of NULL values
+ * @param range(2) the length of CHARACTER values
+ * @param range(3) the number of rows in a batch
+ */
+template <AtomType Type>
+void decode_batch(benchmark::State& state) {
+    auto columns = static_cast<std::size_t>(state.range(0));
+    synthetic_column column{Type, static_cast<double>(state.range(1)) / 100.0, static_cast<std::size_t>(state.range(2))};
+    auto batch_size = static_cast<std::size_t>(state.range(3));
+
+    session s{};
+    synthetic_resultset resultset{std::vector<synthetic_column>(columns, column), rows_per_query};
+    ResultSetPtr result_set{};
+    auto query = [&s, &resultset, &result_set]() {
+        result_set = nullptr;
+        resultset.rewind();
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        s.get_server().response_with_resultset(resultset, ro);
+        return s.transaction().execute_query("SELECT * FROM T", result_set) == ERROR_CODE::OK;
+    };
+    if (!query()) {
+        state.SkipWithError("execute_query failed");
+        return;
+    }
+
+    ogawayama::stub::row_batch batch{};
+    std::size_t rows{};
+    for (auto _ : state) {
+        if (result_set->next_batch(batch_size, batch) != ERROR_CODE::OK) {
+            state.PauseTiming();
+            if (!query() || result_set->next_batch(batch_size, batch) != ERROR_CODE::OK) {
+                state.SkipWithError("execute_query failed");
+                break;
+            }
+            state.ResumeTiming();
+        }
+        rows += batch.size();
+        benchmark::DoNotOptimize(batch);
+    }
+    result_set = nullptr;
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(rows));
+    state.counters["column_time"] = benchmark::Counter(static_cast<double>(rows * columns), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+std::unique_ptr<session> shared_session{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/**
+ * @brief statements are executed by the benchmark threads concurrently, each in its own transaction.
+ * @param range(0) 1 if the responses are received by the dispatcher thread, 0 by the leader election
+ */
+void execute_statement(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        boost::property_tree::ptree option{};
+        option.put(ogawayama::stub::RESPONSE_DISPATCHER, state.range(0) != 0);
+        option.put(ogawayama::stub::SLOT_BLOCKING, true);
+        shared_session = std::make_unique<session>(option, state.threads());
+
+        jogasaki::proto::sql::response::ExecuteResult er{};
+        auto* c = er.mutable_success()->add_counters();
+        c->set_type(jogasaki::proto::sql::response::ExecuteResult::INSERTED_ROWS);
+        c->set_value(1);
+        shared_session->get_server().default_response(er);
+    }
+
+    std::size_t num_rows{};
+    for (auto _ : state) {
+        if (shared_session->transaction(state.thread_index()).execute_statement("INSERT INTO T VALUES (1)", num_rows) != ERROR_CODE::OK) {
+            state.SkipWithError("execute_statement failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        shared_session->get_server().clear_default_response();
+        shared_session = nullptr;
+    }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(decode, std::int32_t, AtomType::INT4)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {0}});
+BENCHMARK_TEMPLATE(decode, std::int64_t, AtomType::INT8)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {0}});
+BENCHMARK_TEMPLATE(decode, float, AtomType::FLOAT4)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {0}});
+BENCHMARK_TEMPLATE(decode, double, AtomType::FLOAT8)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {0}});
+BENCHMARK_TEMPLATE(decode, std::string_view, AtomType::CHARACTER)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {8, 64, 1024}});
+BENCHMARK_TEMPLATE(decode, takatori::decimal::triple, AtomType::DECIMAL)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {0}});
+BENCHMARK_TEMPLATE(decode, takatori::datetime::date, AtomType::DATE)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {0}});
+BENCHMARK_TEMPLATE(decode, takatori::datetime::time_of_day, AtomType::TIME_OF_DAY)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {0}});
+BENCHMARK_TEMPLATE(decode, takatori::datetime::time_point, AtomType::TIME_POINT)
+    ->ArgNames({"columns", "null_percent", "length"})->ArgsProduct({{1, 8}, {0, 10}, {0}});
+
+BENCHMARK_TEMPLATE(decode_batch, AtomType::INT8)
+    ->ArgNames({"columns", "null_percent", "length", "batch"})->ArgsProduct({{1, 8}, {0, 10}, {0}, {64, 1024}});
+BENCHMARK_TEMPLATE(decode_batch, AtomType::CHARACTER)
+    ->ArgNames({"columns", "null_percent", "length", "batch"})->ArgsProduct({{1, 8}, {0, 10}, {8, 64, 1024}, {64, 1024}});
+
+BENCHMARK(execute_statement)
+    ->ArgNames({"dispatcher"})->Arg(0)->Arg(1)
+    ->Threads(1)->Threads(4)->Threads(16)
+    ->UseRealTime();
+
+}  // namespace ogawayama::testing
+
+BENCHMARK_MAIN();
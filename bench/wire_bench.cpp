@@ -0,0 +1,354 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "tateyama/transport/client_wire.h"
+
+// micro-benchmarks of the shared memory wires,
+// where the server side runs in a child process forked for each benchmark run
+namespace tateyama::common::wire {
+
+namespace {
+
+constexpr std::size_t shm_overhead = 1024 * 1024;
+
+/**
+ * @brief the shared memory object created for a benchmark run, removed on destruction.
+ */
+class shared_memory {
+public:
+    explicit shared_memory(std::size_t size) : name_("ogawayama-wire-bench-" + std::to_string(getpid())) {
+        boost::interprocess::shared_memory_object::remove(name_.c_str());
+        managed_shm_ = std::make_unique<boost::interprocess::managed_shared_memory>(boost::interprocess::create_only, name_.c_str(), size + shm_overhead);
+    }
+    ~shared_memory() {
+        managed_shm_ = nullptr;
+        boost::interprocess::shared_memory_object::remove(name_.c_str());
+    }
+
+    shared_memory(shared_memory const&) = delete;
+    shared_memory(shared_memory&&) = delete;
+    shared_memory& operator = (shared_memory const&) = delete;
+    shared_memory& operator = (shared_memory&&) = delete;
+
+    [[nodiscard]] boost::interprocess::managed_shared_memory* get() const noexcept {
+        return managed_shm_.get();
+    }
+    [[nodiscard]] const std::string& name() const noexcept {
+        return name_;
+    }
+
+private:
+    std::string name_;
+    std::unique_ptr<boost::interprocess::managed_shared_memory> managed_shm_{};
+};
+
+/**
+ * @brief run the body in a child process, which shares the mappings of the shared memory object.
+ */
+template <typename F>
+pid_t spawn(F&& body) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        try {
+            body();
+        } catch (std::exception &ex) {
+            std::cerr << ex.what() << std::endl;
+            _exit(1);
+        }
+        _exit(0);
+    }
+    return pid;
+}
+
+void report_latency(benchmark::State& state, std::vector<std::uint64_t>& samples) {
+    if (samples.empty()) {
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double quantile) {
+        auto index = std::min(samples.size() - 1, static_cast<std::size_t>(quantile * static_cast<double>(samples.size())));
+        return static_cast<double>(samples.at(index));
+    };
+    state.counters["p50_ns"] = at(0.5);
+    state.counters["p99_ns"] = at(0.99);
+    state.counters["p999_ns"] = at(0.999);
+    state.counters["max_ns"] = static_cast<double>(samples.back());
+}
+
+/**
+ * @brief a request is echoed back as the response, the latency of each round trip is sampled.
+ * @param range(0) the message size
+ * @param range(1) the capacity of the request and the response wires
+ */
+void round_trip(benchmark::State& state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto capacity = static_cast<std::size_t>(state.range(1));
+
+    shared_memory shm(capacity * 2);
+    auto* request_wire = shm.get()->construct<unidirectional_message_wire>("request")(shm.get(), capacity);
+    auto* response_wire = shm.get()->construct<unidirectional_response_wire>("response")(shm.get(), capacity);
+    char* request_base = request_wire->get_bip_address(shm.get());
+    char* response_base = response_wire->get_bip_address(shm.get());
+
+    auto pid = spawn([request_wire, response_wire, request_base, response_base]() {
+        std::string buffer{};
+        while (true) {
+            message_header header{};
+            try {
+                header = request_wire->peep(request_base);
+            } catch (std::runtime_error &ex) {
+                continue;
+            }
+            if (header.get_idx() == message_header::terminate_request) {
+                break;
+            }
+            buffer.resize(header.get_length());
+            request_wire->read(buffer.data(), request_base);
+            response_wire->write(response_base, buffer.data(), response_header(header.get_idx(), header.get_length(), 1));
+        }
+    });
+
+    std::string message(size, 'x');
+    std::string reply(size, '\0');
+    std::vector<std::uint64_t> samples{};
+    for (auto _ : state) {
+        auto begin = std::chrono::steady_clock::now();
+        request_wire->write(request_base, message.data(), message_header(0, size));
+        response_wire->await(response_base);
+        std::string_view view{};
+        if (response_wire->payload_in_place(response_base, view)) {
+            benchmark::DoNotOptimize(view.data());
+            response_wire->dispose_payload();
+        } else {
+            response_wire->read(reply.data(), response_base);
+        }
+        samples.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+    }
+    request_wire->terminate();
+    waitpid(pid, nullptr, 0);
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size * 2));
+    report_latency(state, samples);
+}
+
+/**
+ * @brief requests are written in place by the client and discarded by the server.
+ * @param range(0) the message size
+ * @param range(1) the capacity of the request wire
+ */
+void request_stream(benchmark::State& state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto capacity = static_cast<std::size_t>(state.range(1));
+
+    shared_memory shm(capacity);
+    auto* request_wire = shm.get()->construct<unidirectional_message_wire>("request")(shm.get(), capacity);
+    char* request_base = request_wire->get_bip_address(shm.get());
+
+    auto pid = spawn([request_wire, request_base]() {
+        while (true) {
+            message_header header{};
+            try {
+                header = request_wire->peep(request_base);
+            } catch (std::runtime_error &ex) {
+                continue;
+            }
+            if (header.get_idx() == message_header::terminate_request) {
+                break;
+            }
+            benchmark::DoNotOptimize(request_wire->payload(request_base).data());
+            request_wire->dispose();
+        }
+    });
+
+    std::string message(size, 'x');
+    std::size_t known_poped{};
+    for (auto _ : state) {
+        if (auto* top = request_wire->reserve(request_base, size, known_poped); top != nullptr) {
+            std::memcpy(top, message.data(), size);
+            request_wire->commit(request_base, message_header(0, size));
+        } else {
+            request_wire->write(request_base, message.data(), message_header(0, size));
+        }
+    }
+    request_wire->terminate();
+    waitpid(pid, nullptr, 0);
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+/**
+ * @brief responses are written by the server as fast as possible and read by the client.
+ * @param range(0) the message size
+ * @param range(1) the capacity of the response wire
+ */
+void response_stream(benchmark::State& state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto capacity = static_cast<std::size_t>(state.range(1));
+
+    shared_memory shm(capacity);
+    auto* response_wire = shm.get()->construct<unidirectional_response_wire>("response")(shm.get(), capacity);
+    auto* stop = shm.get()->construct<std::atomic_bool>("stop")(false);
+    char* response_base = response_wire->get_bip_address(shm.get());
+
+    auto pid = spawn([response_wire, response_base, stop, size]() {
+        std::string message(size, 'x');
+        while (!stop->load()) {
+            response_wire->write(response_base, message.data(), response_header(0, size, 1));
+        }
+    });
+
+    std::string reply(size, '\0');
+    for (auto _ : state) {
+        response_wire->await(response_base);
+        std::string_view view{};
+        if (response_wire->payload_in_place(response_base, view)) {
+            benchmark::DoNotOptimize(view.data());
+            response_wire->dispose_payload();
+        } else {
+            response_wire->read(reply.data(), response_base);
+        }
+    }
+    stop->store(true);
+    response_wire->close();
+    waitpid(pid, nullptr, 0);
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+/**
+ * @brief records are written by the server as fast as possible and read by the client
+ *  the way resultset_wires_container does.
+ * @param range(0) the record size
+ * @param range(1) the capacity of the result set buffer
+ * @param range(2) the number of records read before their space is returned
+ * @param range(3) 1 if the buffer is mapped twice back to back
+ */
+void resultset_stream(benchmark::State& state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto capacity = static_cast<std::size_t>(state.range(1));
+    auto batch = static_cast<std::size_t>(state.range(2));
+    bool mirroring = state.range(3) != 0;
+
+    shared_memory shm(capacity * 2);
+    auto* wires = shm.get()->construct<shm_resultset_wires>("resultset")(shm.get(), 1, capacity);
+    auto* stop = shm.get()->construct<std::atomic_bool>("stop")(false);
+    auto* wire = wires->acquire();
+    char* base = wire->get_bip_address(shm.get());
+
+    std::unique_ptr<mirrored_mapping> mirror{};
+    if (mirroring) {
+        auto offset = static_cast<std::size_t>(wire->get_handle());
+        int fd = shm_open(("/" + shm.name()).c_str(), O_RDONLY, 0);
+        if (fd < 0 || !mirrored_mapping::mappable(offset, capacity)) {
+            state.SkipWithError("the result set buffer cannot be mirrored");
+            return;
+        }
+        mirror = std::make_unique<mirrored_mapping>(fd, offset, capacity);
+        ::close(fd);
+    }
+
+    auto pid = spawn([wire, stop, size]() {
+        std::string record(size, 'x');
+        while (!stop->load()) {
+            wire->write(record.data(), record.size());
+            wire->flush();
+        }
+    });
+
+    std::string scratch{};
+    std::size_t known_valid{};
+    std::size_t unreleased{};
+    std::size_t unreleased_records{};
+    auto release = [wire, &unreleased, &unreleased_records]() {
+        if (unreleased > 0) {
+            wire->release(unreleased);
+            unreleased = 0;
+            unreleased_records = 0;
+        }
+    };
+    for (auto _ : state) {
+        while (!wire->has_record(unreleased, known_valid)) {
+            release();
+            try {
+                (void) wires->active_wire();
+            } catch (std::runtime_error &ex) {
+                continue;
+            }
+        }
+        std::string_view chunk{};
+        if (mirror) {
+            chunk = wire->get_chunk_mirrored(mirror->base(), unreleased);
+        } else {
+            std::string_view extrusion{};
+            chunk = wire->get_chunk(base, extrusion, unreleased);
+            if (!extrusion.empty()) {
+                scratch = chunk;
+                scratch += extrusion;
+                chunk = scratch;
+            }
+        }
+        benchmark::DoNotOptimize(chunk.data());
+        unreleased += wire->chunk_size();
+        if (++unreleased_records >= batch || unreleased * 2 >= capacity || wire->writer_waiting()) {
+            release();
+        }
+    }
+    release();
+    stop->store(true);
+    wires->set_closed();
+    waitpid(pid, nullptr, 0);
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+}  // namespace
+
+// the sizes not dividing the capacities let the messages wrap around the ring buffer,
+// and the ones exceeding the capacity are sent in several pieces
+BENCHMARK(round_trip)
+    ->ArgNames({"size", "capacity"})
+    ->ArgsProduct({{64, 1000, 16384}, {4096, 65536}})
+    ->UseRealTime();
+BENCHMARK(request_stream)
+    ->ArgNames({"size", "capacity"})
+    ->ArgsProduct({{64, 1000, 16384}, {4096, 65536}})
+    ->UseRealTime();
+BENCHMARK(response_stream)
+    ->ArgNames({"size", "capacity"})
+    ->ArgsProduct({{64, 1000, 16384}, {4096, 65536}})
+    ->UseRealTime();
+BENCHMARK(resultset_stream)
+    ->ArgNames({"size", "capacity", "batch", "mirror"})
+    ->ArgsProduct({{64, 1000, 4100}, {65536, 1048576}, {1, 16}, {0, 1}})
+    ->UseRealTime();
+
+}  // namespace tateyama::common::wire
+
+BENCHMARK_MAIN();
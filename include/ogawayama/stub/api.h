@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <future>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -24,8 +25,13 @@
 #include <boost/property_tree/ptree.hpp>
 
 #include <ogawayama/stub/metadata.h>
+#include <ogawayama/stub/row_batch.h>
 #include <ogawayama/stub/error_code.h>
 #include <ogawayama/stub/transaction_option.h>
+#include <ogawayama/stub/commit_option.h>
+#include <ogawayama/stub/dump_option.h>
+#include <ogawayama/stub/connection_option.h>
+#include <ogawayama/stub/connection_pool_option.h>
 #include <ogawayama/stub/Command.h>
 #include <ogawayama/stub/table_metadata.h>
 #include <ogawayama/stub/table_list.h>
@@ -41,7 +47,13 @@ class Transaction;
 class PreparedStatement;
 class Connection;
 class Stub;
- 
+class connection_pool;
+
+using value_type = std::variant<std::monostate, std::int32_t, std::int64_t, float, double, std::string, binary_type, date_type, time_type, timestamp_type, timetz_type, timestamptz_type, decimal_type>;
+using parameters_type = std::vector<std::pair<std::string, value_type>>;
+using load_column_type = std::variant<std::size_t, std::string>;  // the position from 0 or the name of a column in the files to be loaded
+using column_mapping_type = std::vector<std::pair<std::string, load_column_type>>;  // the placeholder name and the column
+
 /**
  * @Brief Result of a query.
  */
@@ -87,6 +99,62 @@ public:
     template<typename T>
     ErrorCode next_column(T& value);
 
+    /**
+     * @brief decode the rows following the current one into the batch column by column.
+     *  The rest of the current row is skipped if it has been read partway.
+     * @param max_rows the maximum number of rows to decode
+     * @param batch returns the rows decoded, which replace the ones it has had,
+     *  only the complete rows before the one failed if COLUMN_TYPE_MISMATCH is returned
+     * @return error code defined in error_code.h, END_OF_ROW if no rows are left
+     */
+    ErrorCode next_batch(std::size_t max_rows, row_batch& batch);
+
+    /**
+     * @brief move current to the next row and decode all of its columns at once.
+     * @param row returns the values of the columns, std::monostate for NULL
+     * @return error code defined in error_code.h, END_OF_ROW if no rows are left
+     */
+    ErrorCode read_row(std::vector<value_type>& row);
+
+    /**
+     * @brief skip columns of the current row without decoding them.
+     * @param columns the number of columns to skip
+     * @return error code defined in error_code.h, END_OF_COLUMN if the row has fewer columns left
+     */
+    ErrorCode skip_columns(std::size_t columns);
+
+    /**
+     * @brief skip the rows following the current one without decoding them.
+     *  The next() after this moves current to the row following the ones skipped.
+     * @param rows the number of rows to skip
+     * @return error code defined in error_code.h, END_OF_ROW if fewer rows are left
+     */
+    ErrorCode skip_rows(std::size_t rows);
+
+    /**
+     * @brief set the columns that next_column() returns, the others being skipped without decoded.
+     *  It does not affect next_batch() or read_row(), which decode all the columns.
+     * @param columns a flag for each column which is true if the column is read, or empty to read all of them
+     * @return error code defined in error_code.h
+     */
+    ErrorCode set_projection(std::vector<bool> columns);
+
+    /**
+     * @brief set how often the space of the rows read is returned to the server.
+     *  The space is also returned when the server is waiting for it, or when half the buffer is in use.
+     * @param records the number of rows read before their space is returned, 1 returns it for every row
+     * @param bytes the size of rows read before their space is returned, 0 means no limit by size
+     * @return error code defined in error_code.h
+     */
+    ErrorCode set_release_batch(std::size_t records, std::size_t bytes = 0);
+
+    /**
+     * @brief get the counters of the space returned to the server by this result set
+     * @param statistics returns the counters
+     * @return error code defined in error_code.h
+     */
+    ErrorCode get_release_statistics(release_statistics& statistics);
+
 private:
     std::unique_ptr<Impl> impl_;
 
@@ -108,9 +176,6 @@ using ResultSetPtr = std::shared_ptr<ogawayama::stub::ResultSet>;
 
 namespace ogawayama::stub {
 
-using value_type = std::variant<std::monostate, std::int32_t, std::int64_t, float, double, std::string, binary_type, date_type, time_type, timestamp_type, timetz_type, timestamptz_type, decimal_type>;
-using parameters_type = std::vector<std::pair<std::string, value_type>>;
-
 /**
  * @brief Information about a parameter set for a prepared statement.
  */
@@ -144,6 +209,7 @@ private:
 
     friend class Connection;
     friend class Transaction;
+    friend class ParameterBinder;
 };
 
 }  // namespace ogawayama::stub
@@ -153,6 +219,79 @@ using PreparedStatementPtr = std::unique_ptr<ogawayama::stub::PreparedStatement>
 
 namespace ogawayama::stub {
 
+/**
+ * @brief The parameters of a prepared statement, set by position into a request reused across executions.
+ *  The request is built once with the statement handle and the placeholder names given on prepare,
+ *  in that order, so an execution sends it as is without copying the names or the values.
+ *  Each value is kept until it is set again, and a parameter not set is NULL.
+ */
+class ParameterBinder {
+    class Impl;
+
+public:
+    /**
+     * @brief Construct a new object.
+     * @param prepared_statement the prepared statement whose parameters are bound, which must not be disposed while this is used
+     */
+    explicit ParameterBinder(PreparedStatementPtr& prepared_statement);
+
+    /**
+     * @brief destructs this object.
+     */
+    ~ParameterBinder();
+
+    ParameterBinder(const ParameterBinder&) = delete;
+    ParameterBinder& operator=(const ParameterBinder&) = delete;
+    ParameterBinder(ParameterBinder&&) = delete;
+    ParameterBinder& operator=(ParameterBinder&&) = delete;
+
+    /**
+     * @brief get the number of the parameters.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief set the value of the parameter at the position.
+     * @param index the position of the parameter
+     * @param value the value, a character string being given as std::string_view
+     * @return error code defined in error_code.h, INVALID_PARAMETER if the position is out of range
+     */
+    ErrorCode set(std::size_t index, std::int32_t value);
+    ErrorCode set(std::size_t index, std::int64_t value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, float value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, double value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, std::string_view value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, const binary_type& value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, date_type value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, time_type value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, timestamp_type value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, const timetz_type& value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, const timestamptz_type& value);  ///< @copydoc set(std::size_t, std::int32_t)
+    ErrorCode set(std::size_t index, const decimal_type& value);  ///< @copydoc set(std::size_t, std::int32_t)
+
+    /**
+     * @brief set the parameter at the position to NULL.
+     * @param index the position of the parameter
+     * @return error code defined in error_code.h, INVALID_PARAMETER if the position is out of range
+     */
+    ErrorCode set_null(std::size_t index);
+
+    /**
+     * @brief set all the parameters to NULL.
+     */
+    void clear() noexcept;
+
+private:
+    std::unique_ptr<Impl> impl_;
+
+    /**
+     * @brief get the impl class
+     * @return a pointer to the impl class
+     */
+    auto get_impl() { return impl_.get(); }
+
+    friend class Transaction;
+};
 
 
 /**
@@ -228,18 +367,141 @@ public:
      */
     ErrorCode execute_query(PreparedStatementPtr& prepared_query, parameters_type& parameters, ResultSetPtr& result_set);
 
+    /**
+     * @brief execute a prepared statement with the parameters bound.
+     * @param binder the parameters bound to the prepared statement to be executed
+     * @param num_rows a reference to a variable to which the number of processes
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_statement(ParameterBinder& binder, std::size_t& num_rows);
+
+    /**
+     * @brief execute a prepared query with the parameters bound.
+     * @param binder the parameters bound to the prepared query to be executed
+     * @param result_set returns a result set of the query
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_query(ParameterBinder& binder, ResultSetPtr& result_set);
+
+    /**
+     * @brief execute a prepared statement once for each of the parameter sets, sending them together.
+     *  The parameter sets are split into as few batch requests as the request wire takes each at once.
+     *  A parameter set too large for the request wire by itself is sent alone in a batch request written piece by piece.
+     * @param prepared_statement the prepared statement to be executed
+     * @param parameter_sets the parameter sets, each to be used for an execution of the prepared statement
+     * @param num_rows a reference to a variable to which the total number of processes
+     * @return error code defined in error_code.h, the parameter sets in the requests following the one in error being left
+     */
+    ErrorCode execute_batch(PreparedStatementPtr& prepared_statement, const std::vector<parameters_type>& parameter_sets, std::size_t& num_rows);
+
+    /**
+     * @brief load the files on the server by executing a prepared statement for each of their rows.
+     * @param prepared_statement the prepared statement to be executed
+     * @param files the paths of the Parquet or Arrow files on the server
+     * @param column_mapping the columns of the files, given by position or by name, to be used for the placeholders
+     * @param num_rows a reference to a variable to which the number of processes
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_load(PreparedStatementPtr& prepared_statement, const std::vector<std::string>& files, const column_mapping_type& column_mapping, std::size_t& num_rows);
+
+    /**
+     * @brief execute a query and dump its result into files in the directory on the server.
+     * @param query the SQL query string to be executed
+     * @param directory the directory on the server in which the files are created
+     * @param option the dump option defined in dump_option.h
+     * @param files returns a result set of the paths of the files created, in a column of TEXT
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_dump(std::string_view query, std::string_view directory, const boost::property_tree::ptree& option, ResultSetPtr& files);
+
+    /**
+     * @brief execute a prepared query and dump its result into files in the directory on the server.
+     * @param prepared_query the prepared query to be executed
+     * @param parameters the parameters to be used for execution of the prepared query
+     * @param directory the directory on the server in which the files are created
+     * @param option the dump option defined in dump_option.h
+     * @param files returns a result set of the paths of the files created, in a column of TEXT
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_dump(PreparedStatementPtr& prepared_query, const parameters_type& parameters, std::string_view directory, const boost::property_tree::ptree& option, ResultSetPtr& files);
+
     /**
      * @brief commit the current transaction.
      * @return error code defined in error_code.h
      */
     ErrorCode commit();
 
+    /**
+     * @brief commit the current transaction with the options.
+     *  With auto_dispose, the server disposes the transaction on the success of the commit,
+     *  which saves the round trip of the request to dispose it.
+     * @param option the commit option defined in commit_option.h
+     * @return error code defined in error_code.h
+     */
+    ErrorCode commit(const commit_option& option);
+
     /**
      * @brief abort the current transaction.
      * @return error code defined in error_code.h
      */
     ErrorCode rollback();
 
+    /*
+     * The *_async variants send the request and return without waiting for the response,
+     * so that several independent requests can be in flight at once.
+     * The response is received when get() or wait() is called on the future, in the calling thread.
+     * The variables given to return the results must remain valid until then, and
+     * the future must be resolved or dropped before this transaction is destroyed.
+     * A future dropped without being resolved still receives its response, discarding the results.
+     */
+
+    /**
+     * @brief execute a statement asynchronously.
+     * @param statement the SQL statement string to be executed
+     * @param num_rows a reference to a variable to which the number of processes, set when the future is resolved
+     * @return the future of the error code defined in error_code.h
+     */
+    std::future<ErrorCode> execute_statement_async(std::string_view statement, std::size_t& num_rows);
+
+    /**
+     * @brief execute a prepared statement asynchronously.
+     * @param prepared_statement the prepared statement to be executed
+     * @param parameters the parameters to be used for execution of the prepared statement
+     * @param num_rows a reference to a variable to which the number of processes, set when the future is resolved
+     * @return the future of the error code defined in error_code.h
+     */
+    std::future<ErrorCode> execute_statement_async(PreparedStatementPtr& prepared_statement, parameters_type& parameters, std::size_t& num_rows);
+
+    /**
+     * @brief execute a query asynchronously.
+     * @param query the SQL query string to be executed
+     * @param result_set returns a result set of the query when the future is resolved
+     * @return the future of the error code defined in error_code.h
+     */
+    std::future<ErrorCode> execute_query_async(std::string_view query, ResultSetPtr& result_set);
+
+    /**
+     * @brief execute a prepared query asynchronously.
+     * @param prepared_query the prepared query to be executed
+     * @param parameters the parameters to be used for execution of the prepared statement
+     * @param result_set returns a result set of the query when the future is resolved
+     * @return the future of the error code defined in error_code.h
+     */
+    std::future<ErrorCode> execute_query_async(PreparedStatementPtr& prepared_query, parameters_type& parameters, ResultSetPtr& result_set);
+
+    /**
+     * @brief commit the current transaction asynchronously.
+     * @return the future of the error code defined in error_code.h
+     */
+    std::future<ErrorCode> commit_async();
+
+    /**
+     * @brief commit the current transaction with the options asynchronously.
+     * @param option the commit option defined in commit_option.h
+     * @return the future of the error code defined in error_code.h
+     */
+    std::future<ErrorCode> commit_async(const commit_option& option);
+
 private:
     std::unique_ptr<Impl> impl_;
 
@@ -311,6 +573,14 @@ public:
      */
     ErrorCode prepare(std::string_view, const placeholders_type&, PreparedStatementPtr&);
 
+    /**
+     * @brief request prepare asynchronously, the response is received when the future is resolved.
+     * @param SQL statement
+     * @param prepared statement returns a prepared statement class when the future is resolved
+     * @return the future of the error code defined in error_code.h
+     */
+    std::future<ErrorCode> prepare_async(std::string_view, const placeholders_type&, PreparedStatementPtr&);
+
     /**
      * @brief request table metadata and get TableMetadata class.
      * @param table_name the table name
@@ -340,6 +610,13 @@ public:
      */
     ErrorCode tsurugi_error(tsurugi_error_code& code);
 
+    /**
+     * @brief get the counters of the waits for responses and records in this connection
+     * @param statistics returns the number of waits resolved in each phase
+     * @return error code defined in error_code.h
+     */
+    ErrorCode get_wait_statistics(wait_statistics& statistics);
+
 private:
     std::unique_ptr<Impl> impl_;
 
@@ -352,6 +629,7 @@ private:
     friend class Stub;
     friend class PreparedStatement::Impl;
     friend class Transaction::Impl;
+    friend class connection_pool;
 };
 
 }  // namespace ogawayama::stub
@@ -431,6 +709,51 @@ public:
         return get_connection(connection, n, auth);
     }
 
+    /**
+     * @brief connect to the DB with connection option and get Connection class.
+     * @param connection returns a connection class
+     * @param n supposed to be given MyProc->pgprocno for the first param // obsolete
+     * @param option the connection option defined in connection_option.h
+     * @return error code defined in error_code.h
+     */
+    ErrorCode get_connection(ConnectionPtr& connection, std::size_t n, const boost::property_tree::ptree& option);
+
+    /**
+     * @brief connect to the DB with connection option and get Connection class.
+     * @param connection returns a connection class
+     * @param n supposed to be given MyProc->pgprocno for the first param // obsolete
+     * @param auth the authentication information
+     * @param option the connection option defined in connection_option.h
+     * @return error code defined in error_code.h
+     */
+    ErrorCode get_connection(ConnectionPtr& connection, std::size_t n, const Auth& auth, const boost::property_tree::ptree& option);
+
+    /**
+     * @brief open the pool of the sessions handshaked in advance, which replaces the one opened before.
+     *  The get_connection() with the same connection option and without authentication information takes
+     *  a session from the pool, and the session is returned to the pool when the Connection is destructed.
+     * @param pool_option the pool option defined in connection_pool_option.h
+     * @param option the connection option of the sessions defined in connection_option.h
+     * @return error code defined in error_code.h
+     */
+    ErrorCode open_connection_pool(const boost::property_tree::ptree& pool_option, const boost::property_tree::ptree& option);
+
+    /**
+     * @brief open the pool of the sessions handshaked in advance, which replaces the one opened before.
+     *  The get_connection() with the same authentication information and connection option takes
+     *  a session from the pool, and the session is returned to the pool when the Connection is destructed.
+     * @param pool_option the pool option defined in connection_pool_option.h
+     * @param auth the authentication information
+     * @param option the connection option of the sessions defined in connection_option.h
+     * @return error code defined in error_code.h
+     */
+    ErrorCode open_connection_pool(const boost::property_tree::ptree& pool_option, const Auth& auth, const boost::property_tree::ptree& option);
+
+    /**
+     * @brief close the sessions in the pool, the Connections taken from it being closed when destructed.
+     */
+    void close_connection_pool();
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -447,6 +770,7 @@ private:
     friend class Transaction::Impl;
     friend class ResultSet;
     friend class ResultSet::Impl;
+    friend class connection_pool;
 };
 
 }  // namespace ogawayama::stub
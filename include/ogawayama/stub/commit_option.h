@@ -0,0 +1,39 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+namespace ogawayama::stub {
+
+    /**
+     * @brief the commit status to be reached before the commit is notified.
+     */
+    enum CommitStatus {
+        COMMIT_STATUS_UNSPECIFIED = 0,  // rely on the database settings
+        ACCEPTED = 10,                  // the transaction will never abort except system errors
+        AVAILABLE = 20,                 // the committed data are visible for others
+        STORED = 30,                    // the committed data are saved on the local disk
+        PROPAGATED = 40,                // the committed data are propagated to all the suitable nodes
+    };
+
+    /**
+     * @brief the options of a commit, passed to Transaction::commit().
+     */
+    struct commit_option {
+        CommitStatus notification_type{COMMIT_STATUS_UNSPECIFIED};  // the commit status to wait for
+        bool auto_dispose{true};  // let the server dispose the transaction on the success of the commit
+    };
+
+}  // ogawayama::stub
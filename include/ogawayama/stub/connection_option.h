@@ -0,0 +1,105 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+/* ConnectionOption consists of the following fields
+    + waitSpinCount        std::uint32_t (the number of busy-wait iterations before yielding, 0 by default)
+    + waitYieldCount       std::uint32_t (the number of yields before blocking, 0 by default)
+    + slotCount            std::size_t (the number of requests that can be in flight at once, 16 by default)
+    + slotBlocking         bool (wait for a slot to be released when all slots are in use, false by default)
+    + slotTimeout          std::uint64_t (the limit in milliseconds of the wait for a slot, 0 means no limit)
+    + responseDispatcher   bool (receive responses by a dedicated thread, false by default)
+    + resultSetMirroring   bool (map result set buffers twice back to back to read records in place, false by default)
+    + deferredDisposal     bool (send the cleanup of transactions and result sets without waiting for it, false by default)
+    + disposalQueueSize    std::size_t (the number of cleanup requests that can be pending at once, 4 by default)
+ *
+ * They are supposed to be stored in a boost::property_tree::ptree and passed to Stub::get_connection() API.
+ * Use the labels on the left above for field names in the ptree
+ */
+
+namespace ogawayama::stub {
+    /**
+     * @brief Field name constant indicating the number of busy-wait iterations
+     *  before yielding in waiting for a response or a record.
+     */
+    static constexpr const char* WAIT_SPIN_COUNT = "waitSpinCount";
+    /**
+     * @brief Field name constant indicating the number of yields
+     *  before blocking in waiting for a response or a record.
+     */
+    static constexpr const char* WAIT_YIELD_COUNT = "waitYieldCount";
+    /**
+     * @brief Field name constant indicating the number of requests
+     *  that can be in flight at once on a connection.
+     */
+    static constexpr const char* SLOT_COUNT = "slotCount";
+    /**
+     * @brief Field name constant indicating whether to wait for a slot
+     *  to be released instead of failing when all slots are in use.
+     */
+    static constexpr const char* SLOT_BLOCKING = "slotBlocking";
+    /**
+     * @brief Field name constant indicating the limit in milliseconds
+     *  of the wait for a slot to be released.
+     */
+    static constexpr const char* SLOT_TIMEOUT = "slotTimeout";
+    /**
+     * @brief Field name constant indicating whether a dedicated thread receives the responses
+     *  and wakes the thread waiting for each of them.
+     */
+    static constexpr const char* RESPONSE_DISPATCHER = "responseDispatcher";
+    /**
+     * @brief Field name constant indicating whether to map each result set buffer twice back to back,
+     *  so that records wrapping around the end of the buffer are read without being copied.
+     *  Takes effect only for the buffers page aligned in the shared memory.
+     */
+    static constexpr const char* RESULTSET_MIRRORING = "resultSetMirroring";
+    /**
+     * @brief Field name constant indicating whether to send the rollback and the disposal of
+     *  transactions abandoned or finished, and the close of result sets, without waiting for their responses,
+     *  which are received before the next transaction begins, when a request finds no free slot
+     *  and when the connection is closed.
+     */
+    static constexpr const char* DEFERRED_DISPOSAL = "deferredDisposal";
+    /**
+     * @brief Field name constant indicating the number of cleanup requests
+     *  whose responses can be pending at once with the deferred disposal, less than the slot count.
+     */
+    static constexpr const char* DISPOSAL_QUEUE_SIZE = "disposalQueueSize";
+
+    /**
+     * @brief the number of waits resolved in each phase of the waiting strategy.
+     */
+    struct wait_statistics {
+        std::uint64_t immediate{};  // data had already arrived
+        std::uint64_t spin{};       // resolved while busy-waiting
+        std::uint64_t yield{};      // resolved while yielding
+        std::uint64_t block{};      // resolved after blocking
+    };
+
+    /**
+     * @brief the counters of the space of records returned to the server by a result set.
+     */
+    struct release_statistics {
+        std::uint64_t releases{};       // the number of times the space has been returned
+        std::uint64_t records{};        // the number of records whose space has been returned
+        std::uint64_t bytes{};          // the size of the space returned
+        std::uint64_t writer_stalls{};  // the releases made while the server has been waiting for the space
+    };
+
+}  // ogawayama::stub
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+/* ConnectionPoolOption consists of the following fields
+    + minSize              std::size_t (the number of sessions kept in the pool even if idle, 0 by default)
+    + maxSize              std::size_t (the number of sessions that can be kept in the pool, 4 by default)
+    + idleTimeout          std::uint64_t (the time in milliseconds a session beyond minSize is kept idle, 0 means no limit)
+ *
+ * They are supposed to be stored in a boost::property_tree::ptree and passed to Stub::open_connection_pool() API.
+ * Use the labels on the left above for field names in the ptree
+ */
+
+namespace ogawayama::stub {
+    /**
+     * @brief Field name constant indicating the number of sessions
+     *  kept in the connection pool even if they are idle, which are opened when the pool is opened.
+     */
+    static constexpr const char* POOL_MIN_SIZE = "minSize";
+    /**
+     * @brief Field name constant indicating the number of sessions that can be kept in the connection pool,
+     *  the sessions returned beyond it being closed.
+     */
+    static constexpr const char* POOL_MAX_SIZE = "maxSize";
+    /**
+     * @brief Field name constant indicating the time in milliseconds
+     *  a session beyond the minimum size is kept idle in the connection pool before closed.
+     */
+    static constexpr const char* POOL_IDLE_TIMEOUT = "idleTimeout";
+
+}  // ogawayama::stub
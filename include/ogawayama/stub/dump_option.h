@@ -0,0 +1,131 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+/* DumpOption consists of the following fields
+    + failBehavior           enum DumpFailBehavior
+    + maxRecordCountPerFile  std::uint64_t (the limit of the number of records in a file)
+    + timestampUnit          enum TimeUnit (the unit of the timestamp columns)
+    + parquet                (dump the result as Apache Parquet files, exclusive with arrow)
+      + parquetVersion         std::string
+      + recordBatchSize        std::int64_t (the maximum number of rows in a row group)
+      + recordBatchInBytes     std::int64_t (the approximate maximum size of a row group)
+      + codec                  std::string (the compression codec of the columns)
+      + encoding               std::string (the encoding of the columns)
+      + columns                array of the settings of the individual columns
+        + columnName             std::string
+        + codec                  std::string (overwrites the one of the file)
+        + encoding               std::string (overwrites the one of the file)
+        + ...                    the same as the above
+    + arrow                  (dump the result as Apache Arrow files, exclusive with parquet)
+      + metadataVersion        std::string
+      + alignment              std::int32_t (the byte alignment of the values)
+      + recordBatchSize        std::int64_t (the maximum number of records in a record batch)
+      + recordBatchInBytes     std::int64_t (the approximate maximum size of a record batch)
+      + codec                  std::string (the compression codec)
+      + minSpaceSaving         double (the threshold for adopting the compressed data)
+      + characterFieldType     enum ArrowCharacterFieldType
+ *
+ * They are supposed to be stored in a boost::property_tree::ptree and passed to Transaction::execute_dump() API.
+ * Use the labels on the left above for field names in the ptree
+ */
+
+namespace ogawayama::stub {
+    /**
+     * @brief Field name constant indicating the behavior on the failure of the dump.
+     */
+    static constexpr const char* DUMP_FAIL_BEHAVIOR = "failBehavior";
+    /**
+     * @brief Field name constant indicating the maximum number of records in a dump file.
+     */
+    static constexpr const char* MAX_RECORD_COUNT_PER_FILE = "maxRecordCountPerFile";
+    /**
+     * @brief Field name constant indicating the unit of the timestamp columns in dump files.
+     */
+    static constexpr const char* TIMESTAMP_UNIT = "timestampUnit";
+    /**
+     * @brief Field name constant indicating the settings of the Apache Parquet file format.
+     */
+    static constexpr const char* PARQUET = "parquet";
+    /**
+     * @brief Field name constant indicating the settings of the Apache Arrow file format.
+     */
+    static constexpr const char* ARROW = "arrow";
+    /**
+     * @brief Field name constant indicating the parquet file format version.
+     */
+    static constexpr const char* PARQUET_VERSION = "parquetVersion";
+    /**
+     * @brief Field name constant indicating the arrow metadata format version.
+     */
+    static constexpr const char* METADATA_VERSION = "metadataVersion";
+    /**
+     * @brief Field name constant indicating the maximum number of records in a row group or a record batch.
+     */
+    static constexpr const char* RECORD_BATCH_SIZE = "recordBatchSize";
+    /**
+     * @brief Field name constant indicating the approximate maximum size in bytes of a row group or a record batch.
+     */
+    static constexpr const char* RECORD_BATCH_IN_BYTES = "recordBatchInBytes";
+    /**
+     * @brief Field name constant indicating the compression codec name.
+     */
+    static constexpr const char* CODEC = "codec";
+    /**
+     * @brief Field name constant indicating the encoding type name.
+     */
+    static constexpr const char* ENCODING = "encoding";
+    /**
+     * @brief Field name constant indicating the settings of the individual columns of the parquet files.
+     */
+    static constexpr const char* COLUMNS = "columns";
+    /**
+     * @brief Field name constant indicating the column name in the settings of the individual columns.
+     */
+    static constexpr const char* COLUMN_NAME = "columnName";
+    /**
+     * @brief Field name constant indicating the byte alignment of the values in the arrow files.
+     */
+    static constexpr const char* ALIGNMENT = "alignment";
+    /**
+     * @brief Field name constant indicating the threshold for adopting the compressed data in the arrow files.
+     */
+    static constexpr const char* MIN_SPACE_SAVING = "minSpaceSaving";
+    /**
+     * @brief Field name constant indicating the metadata type of the CHAR columns in the arrow files.
+     */
+    static constexpr const char* CHARACTER_FIELD_TYPE = "characterFieldType";
+
+    enum DumpFailBehavior {
+        DUMP_FAIL_BEHAVIOR_UNSPECIFIED = 0,
+        DELETE_FILES = 1,
+        KEEP_FILES = 2,
+    };
+
+    enum TimeUnit {
+        TIME_UNIT_UNSPECIFIED = 0,
+        NANOSECOND = 1,
+        MICROSECOND = 2,
+        MILLISECOND = 3,
+    };
+
+    enum ArrowCharacterFieldType {
+        ARROW_CHARACTER_FIELD_TYPE_UNSPECIFIED = 0,
+        STRING = 1,
+        FIXED_SIZE_BINARY = 2,
+    };
+
+}  // ogawayama::stub
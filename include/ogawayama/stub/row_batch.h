@@ -0,0 +1,309 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <ogawayama/stub/metadata.h>
+
+namespace ogawayama::stub {
+
+/**
+ * @brief the values of a column for the rows of a row_batch, stored contiguously.
+ *  The values of NULL entries are left default constructed so that the value of a row is at its index,
+ *  and TEXT and OCTET values are stored back to back in a byte array delimited by offsets.
+ */
+class column_vector {
+public:
+    using storage_type = std::variant<
+        std::monostate,  // TEXT and OCTET, stored in offsets_ and bytes_
+        std::vector<std::int32_t>,
+        std::vector<std::int64_t>,
+        std::vector<float>,
+        std::vector<double>,
+        std::vector<date_type>,
+        std::vector<time_type>,
+        std::vector<timestamp_type>,
+        std::vector<timetz_type>,
+        std::vector<timestamptz_type>,
+        std::vector<decimal_type>>;
+
+    /**
+     * @brief Construct a new object.
+     * @param type the type of the column
+     */
+    explicit column_vector(Metadata::ColumnType::Type type) : type_(type), values_(storage_of(type)) {}
+
+    /**
+     * @brief get type for this column.
+     * @return Type of this column
+     */
+    [[nodiscard]] Metadata::ColumnType::Type type() const noexcept { return type_; }
+
+    /**
+     * @brief get the number of rows stored.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief check whether the value of the row is NULL.
+     * @param row the index of the row
+     */
+    [[nodiscard]] bool is_null(std::size_t row) const noexcept {
+        return (nulls_[row / bits] & (std::uint64_t{1} << (row % bits))) != 0;
+    }
+
+    /**
+     * @brief get the number of NULL values stored.
+     */
+    [[nodiscard]] std::size_t null_count() const noexcept { return null_count_; }
+
+    /**
+     * @brief get the null bitmap, in which bit (row % 64) of word (row / 64) is set if the value of the row is NULL.
+     */
+    [[nodiscard]] const std::vector<std::uint64_t>& null_bitmap() const noexcept { return nulls_; }
+
+    /**
+     * @brief get the values of a fixed length column.
+     * @tparam T the value type corresponding to the column type, such as std::int64_t for INT64
+     * @throws std::bad_variant_access if T does not correspond to the column type
+     */
+    template<typename T>
+    [[nodiscard]] const std::vector<T>& values() const { return std::get<std::vector<T>>(values_); }
+
+    /**
+     * @brief get the value of a TEXT or OCTET column.
+     * @param row the index of the row
+     * @return the value, which is empty if NULL
+     */
+    [[nodiscard]] std::string_view text(std::size_t row) const noexcept {
+        return {bytes_.data() + offsets_[row], offsets_[row + 1] - offsets_[row]};
+    }
+
+    /**
+     * @brief get the offsets of the TEXT or OCTET values in bytes(), which has size() + 1 entries.
+     */
+    [[nodiscard]] const std::vector<std::size_t>& offsets() const noexcept { return offsets_; }
+
+    /**
+     * @brief get the TEXT or OCTET values stored back to back.
+     */
+    [[nodiscard]] const std::string& bytes() const noexcept { return bytes_; }
+
+    /**
+     * @brief append a value to a fixed length column.
+     * @tparam T the value type corresponding to the column type
+     */
+    template<typename T>
+    void push(T value) {
+        std::get<std::vector<T>>(values_).emplace_back(value);
+        push_bit(false);
+    }
+
+    /**
+     * @brief append a value to a TEXT or OCTET column.
+     */
+    void push_text(std::string_view value) {
+        bytes_.append(value);
+        offsets_.emplace_back(bytes_.size());
+        push_bit(false);
+    }
+
+    /**
+     * @brief append a NULL value.
+     */
+    void push_null() {
+        if (std::holds_alternative<std::monostate>(values_)) {
+            offsets_.emplace_back(bytes_.size());
+        } else {
+            std::visit([](auto& v){
+                if constexpr (!std::is_same_v<std::decay_t<decltype(v)>, std::monostate>) {
+                    v.emplace_back();
+                }
+            }, values_);
+        }
+        push_bit(true);
+        null_count_++;
+    }
+
+    /**
+     * @brief remove all the rows, retaining the memory allocated.
+     */
+    void clear() noexcept {
+        std::visit([](auto& v){
+            if constexpr (!std::is_same_v<std::decay_t<decltype(v)>, std::monostate>) {
+                v.clear();
+            }
+        }, values_);
+        offsets_.resize(1);
+        bytes_.clear();
+        nulls_.clear();
+        size_ = 0;
+        null_count_ = 0;
+    }
+
+    /**
+     * @brief remove the rows following the number of rows given, retaining the memory allocated.
+     * @param rows the number of rows kept
+     */
+    void truncate(std::size_t rows) noexcept {
+        if (rows >= size_) {
+            return;
+        }
+        for (std::size_t row = rows; row < size_; row++) {
+            if (is_null(row)) {
+                null_count_--;
+            }
+        }
+        if (std::holds_alternative<std::monostate>(values_)) {
+            bytes_.resize(offsets_[rows]);
+            offsets_.resize(rows + 1);
+        } else {
+            std::visit([rows](auto& v){
+                if constexpr (!std::is_same_v<std::decay_t<decltype(v)>, std::monostate>) {
+                    v.resize(rows);
+                }
+            }, values_);
+        }
+        nulls_.resize((rows + bits - 1) / bits);
+        if (rows % bits != 0) {
+            nulls_.back() &= (std::uint64_t{1} << (rows % bits)) - 1;
+        }
+        size_ = rows;
+    }
+
+private:
+    static constexpr std::size_t bits = 64;
+
+    Metadata::ColumnType::Type type_;
+    storage_type values_;
+    std::vector<std::size_t> offsets_{0};
+    std::string bytes_{};
+    std::vector<std::uint64_t> nulls_{};
+    std::size_t size_{};
+    std::size_t null_count_{};
+
+    void push_bit(bool null) {
+        if (size_ % bits == 0) {
+            nulls_.emplace_back(0);
+        }
+        if (null) {
+            nulls_.back() |= std::uint64_t{1} << (size_ % bits);
+        }
+        size_++;
+    }
+
+    static storage_type storage_of(Metadata::ColumnType::Type type) {
+        switch (type) {
+        case Metadata::ColumnType::Type::INT32: return std::vector<std::int32_t>{};
+        case Metadata::ColumnType::Type::INT64: return std::vector<std::int64_t>{};
+        case Metadata::ColumnType::Type::FLOAT32: return std::vector<float>{};
+        case Metadata::ColumnType::Type::FLOAT64: return std::vector<double>{};
+        case Metadata::ColumnType::Type::DATE: return std::vector<date_type>{};
+        case Metadata::ColumnType::Type::TIME: return std::vector<time_type>{};
+        case Metadata::ColumnType::Type::TIMESTAMP: return std::vector<timestamp_type>{};
+        case Metadata::ColumnType::Type::TIMETZ: return std::vector<timetz_type>{};
+        case Metadata::ColumnType::Type::TIMESTAMPTZ: return std::vector<timestamptz_type>{};
+        case Metadata::ColumnType::Type::DECIMAL: return std::vector<decimal_type>{};
+        default: return std::monostate{};
+        }
+    }
+};
+
+/**
+ * @brief a batch of rows of a ResultSet decoded column by column, filled by ResultSet::next_batch().
+ */
+class row_batch {
+public:
+    /**
+     * @brief Construct a new object.
+     */
+    row_batch() = default;
+
+    /**
+     * @brief get the number of rows in this batch.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return columns_.empty() ? 0 : columns_.front().size(); }
+
+    /**
+     * @brief check whether this batch has no rows.
+     */
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief get the number of columns.
+     */
+    [[nodiscard]] std::size_t column_count() const noexcept { return columns_.size(); }
+
+    /**
+     * @brief get a column.
+     * @param index the column number, begins from zero
+     */
+    [[nodiscard]] const column_vector& column(std::size_t index) const { return columns_.at(index); }
+    [[nodiscard]] column_vector& column(std::size_t index) { return columns_.at(index); }
+
+    /**
+     * @brief remove all the rows and set up the columns of the types given.
+     *  The memory allocated is retained if the types are the same as the current ones.
+     * @param types the types of the columns
+     */
+    void reset(const Metadata::SetOfTypeData& types) {
+        bool same = types.size() == columns_.size();
+        for (std::size_t i = 0; same && i < types.size(); i++) {
+            same = types[i].get_type() == columns_[i].type();
+        }
+        if (same) {
+            clear();
+            return;
+        }
+        columns_.clear();
+        columns_.reserve(types.size());
+        for (auto&& type : types) {
+            columns_.emplace_back(type.get_type());
+        }
+    }
+
+    /**
+     * @brief remove all the rows, retaining the memory allocated.
+     */
+    void clear() noexcept {
+        for (auto&& column : columns_) {
+            column.clear();
+        }
+    }
+
+    /**
+     * @brief remove the rows following the number of rows given from every column,
+     *  including the values of a row whose decoding has failed partway.
+     * @param rows the number of rows kept
+     */
+    void truncate(std::size_t rows) noexcept {
+        for (auto&& column : columns_) {
+            column.truncate(rows);
+        }
+    }
+
+private:
+    std::vector<column_vector> columns_{};
+};
+
+}  // namespace ogawayama::stub
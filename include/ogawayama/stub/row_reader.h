@@ -0,0 +1,148 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <ogawayama/stub/api.h>
+
+namespace ogawayama::stub {
+
+namespace details {
+
+/**
+ * @brief tells whether a column of the type can be read into T by ResultSet::next_column().
+ */
+template<typename T>
+constexpr bool readable_as(Metadata::ColumnType::Type type) noexcept {
+    using Type = Metadata::ColumnType::Type;
+    if constexpr (std::is_same_v<T, std::int32_t>) {
+        return type == Type::INT32;
+    } else if constexpr (std::is_same_v<T, std::int64_t>) {
+        return type == Type::INT32 || type == Type::INT64;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return type == Type::FLOAT32;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return type == Type::FLOAT32 || type == Type::FLOAT64;
+    } else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+        return type == Type::TEXT || type == Type::OCTET;
+    } else if constexpr (std::is_same_v<T, date_type>) {
+        return type == Type::DATE;
+    } else if constexpr (std::is_same_v<T, time_type>) {
+        return type == Type::TIME;
+    } else if constexpr (std::is_same_v<T, timestamp_type>) {
+        return type == Type::TIMESTAMP;
+    } else if constexpr (std::is_same_v<T, timetz_type>) {
+        return type == Type::TIMETZ;
+    } else if constexpr (std::is_same_v<T, timestamptz_type>) {
+        return type == Type::TIMESTAMPTZ;
+    } else if constexpr (std::is_same_v<T, decimal_type>) {
+        return type == Type::DECIMAL || type == Type::INT32 || type == Type::INT64;
+    } else {
+        static_assert(!std::is_same_v<T, T>, "the type cannot be read from a column");
+    }
+}
+
+}  // namespace details
+
+/**
+ * @brief reads the rows of a ResultSet whose column types are known when compiled.
+ *  The column types are checked against the metadata once on construction,
+ *  and each column is then read by the next_column() for its type.
+ *  std::string_view values are valid until the next row is read.
+ * @tparam Ts the types of the columns, such as std::int64_t, std::string_view or date_type
+ */
+template<typename... Ts>
+class RowReader {
+public:
+    using row_type = std::tuple<std::optional<Ts>...>;
+
+    /**
+     * @brief Construct a new object.
+     * @param result_set the result set to read, which must outlive this object
+     */
+    explicit RowReader(ResultSet& result_set) : result_set_(result_set) {
+        MetadataPtr metadata{};
+        if (auto rv = result_set_.get_metadata(metadata); rv != ErrorCode::OK) {
+            status_ = rv;
+            return;
+        }
+        const auto& types = metadata->get_types();
+        if (types.size() != sizeof...(Ts) || !matches(types, std::index_sequence_for<Ts...>{})) {
+            status_ = ErrorCode::COLUMN_TYPE_MISMATCH;
+        }
+    }
+
+    /**
+     * @brief get the result of the type check.
+     * @return OK if Ts match the columns of the result set, COLUMN_TYPE_MISMATCH otherwise
+     */
+    [[nodiscard]] ErrorCode status() const noexcept { return status_; }
+
+    /**
+     * @brief move to the next row and read all of its columns.
+     * @param row returns the values of the columns, std::nullopt for NULL
+     * @return error code defined in error_code.h, END_OF_ROW if no rows are left
+     */
+    ErrorCode next(row_type& row) {
+        if (status_ != ErrorCode::OK) {
+            return status_;
+        }
+        if (auto rv = result_set_.next(); rv != ErrorCode::OK) {
+            return rv;
+        }
+        return read(row, std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    ResultSet& result_set_;
+    ErrorCode status_{ErrorCode::OK};
+
+    template<std::size_t... Is>
+    static bool matches(const Metadata::SetOfTypeData& types, std::index_sequence<Is...>) noexcept {
+        return (details::readable_as<Ts>(types[Is].get_type()) && ...);
+    }
+
+    template<std::size_t... Is>
+    ErrorCode read(row_type& row, std::index_sequence<Is...>) {
+        ErrorCode rv{ErrorCode::OK};
+        (void) (((rv = read_column(std::get<Is>(row))) == ErrorCode::OK) && ...);
+        return rv;
+    }
+
+    template<typename T>
+    ErrorCode read_column(std::optional<T>& column) {
+        T value{};
+        switch (auto rv = result_set_.next_column(value); rv) {
+        case ErrorCode::OK:
+            column = std::move(value);
+            return ErrorCode::OK;
+        case ErrorCode::COLUMN_WAS_NULL:
+            column.reset();
+            return ErrorCode::OK;
+        default:
+            return rv;
+        }
+    }
+};
+
+}  // namespace ogawayama::stub
@@ -2,6 +2,8 @@
 
 #include <cstring>
 
+#include "details/base128v_decoder.h"
+
 namespace jogasaki::serializer::base128v {
 
 using takatori::util::buffer_view;
@@ -53,65 +55,16 @@ bool write_unsigned(
     return true;
 }
 
-template<class Iter>
-static std::optional<std::uint64_t> impl_read_unsigned(
-        Iter& iterator,
-        buffer_view::const_iterator end) noexcept {
-    std::uint64_t result {};
-    auto iter_work = iterator;
-    for (std::uint64_t i = 0; i < 8; ++i) {
-        if (iter_work == end) {
-            return std::nullopt;
-        }
-        auto group = static_cast<std::uint64_t>(static_cast<unsigned char>(*iter_work));
-        if (group == 0 && i != 0) {
-            // for strict, all zeros group is not allowed, except just represents 0
-            return std::nullopt;
-        }
-        ++iter_work;
-
-        // the 1st ~ 8th groups have continue bit.
-        // cvvv vvvv
-        //   c - continue bit
-        //   v - 7-bit value block
-        result |= (group & 0x7fULL) << (i * 7);
-        if ((group & 0x80ULL) == 0) {
-            // end of sequence
-            result |= (group & 0x7fULL) << (i * 7);
-            iterator = iter_work;
-            return { result };
-        }
-        // more groups are rest
-    }
-    if (iter_work == end) {
-        return std::nullopt;
-    }
-
-    auto group = static_cast<std::uint64_t>(static_cast<unsigned char>(*iter_work));
-    if (group == 0) {
-        // for strict, all zeros group is not allowed
-        return std::nullopt;
-    }
-    ++iter_work;
-
-    // the 9th group has no continue bit.
-    // vvvv vvvv
-    //   v - 8-bit value block
-    result |= (group & 0xffULL) << 56ULL;
-    iterator = iter_work;
-    return { result };
-}
-
 std::optional<std::uint64_t> read_unsigned(
         buffer_view::iterator& iterator,
         buffer_view::const_iterator end) noexcept {
-    return impl_read_unsigned(iterator, end);
+    return details::decode_unsigned(iterator, end);
 }
 
 std::optional<std::uint64_t> read_unsigned(
         buffer_view::const_iterator& iterator,
         buffer_view::const_iterator end) noexcept {
-    return impl_read_unsigned(iterator, end);
+    return details::decode_unsigned(iterator, end);
 }
 
 static std::uint64_t encode_signed(std::int64_t value) {
@@ -124,17 +77,6 @@ static std::uint64_t encode_signed(std::int64_t value) {
     return work;
 }
 
-static std::int64_t decode_signed(std::uint64_t encoded) {
-    std::uint64_t work = encoded;
-    work >>= 1ULL;
-    if ((encoded & 0x01ULL) != 0) {
-        work = ~work;
-    }
-    std::int64_t result {};
-    std::memcpy(&result, &work, sizeof(work));
-    return result;
-}
-
 [[nodiscard]] size_type size_signed(std::int64_t value) {
     return size_unsigned(encode_signed(value));
 }
@@ -149,8 +91,8 @@ bool write_signed(
 std::optional<std::int64_t> read_signed(
         buffer_view::iterator& iterator,
         buffer_view::const_iterator end) {
-    if (auto result = impl_read_unsigned(iterator, end)) {
-        return { decode_signed(*result) };
+    if (auto result = details::decode_unsigned(iterator, end)) {
+        return { details::decode_zigzag(*result) };
     }
     return std::nullopt;
 }
@@ -158,8 +100,8 @@ std::optional<std::int64_t> read_signed(
 std::optional<std::int64_t> read_signed(
         buffer_view::const_iterator& iterator,
         buffer_view::const_iterator end) {
-    if (auto result = impl_read_unsigned(iterator, end)) {
-        return { decode_signed(*result) };
+    if (auto result = details::decode_unsigned(iterator, end)) {
+        return { details::decode_zigzag(*result) };
     }
     return std::nullopt;
 }
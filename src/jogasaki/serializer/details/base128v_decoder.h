@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#include <boost/endian/conversion.hpp>
+
+#include <takatori/util/buffer_view.h>
+
+namespace jogasaki::serializer::details {
+
+/**
+ * @brief decodes base128 variant unsigned integer, to be inlined into the decoding loops.
+ * @details a single group is taken by itself, and up to 8 groups are taken at once from a word
+ *      if the buffer has 8 octets left; the rest are taken one group by one.
+ * @param iterator the buffer iterator, which is advanced only if successfully decoded
+ * @param end the buffer ending position
+ * @return the decoded value, or empty if the buffer is broken
+ */
+template<class Iter>
+inline std::optional<std::uint64_t> decode_unsigned(
+        Iter& iterator,
+        takatori::util::buffer_view::const_iterator end) noexcept {
+    // a single group
+    if (iterator != end && (static_cast<unsigned char>(*iterator) & 0x80U) == 0) {
+        auto result = static_cast<std::uint64_t>(static_cast<unsigned char>(*iterator));
+        ++iterator;
+        return { result };
+    }
+
+    // up to 8 groups in a word
+    if (end - iterator >= static_cast<std::ptrdiff_t>(sizeof(std::uint64_t))) {
+        std::uint64_t word {};
+        std::memcpy(&word, &*iterator, sizeof(word));
+        boost::endian::little_to_native_inplace(word);
+
+        // the last group is the first one without continue bit
+        auto stops = ~word & 0x8080808080808080ULL;
+        if (stops != 0) {
+            auto length = static_cast<std::size_t>(__builtin_ctzll(stops) + 1) / 8U;
+            auto bits = length * 8U;
+            if (length < sizeof(std::uint64_t)) {
+                word &= (1ULL << bits) - 1U;
+            }
+            if ((word >> (bits - 8U)) == 0) {
+                // for strict, all zeros group is not allowed, except just represents 0
+                return std::nullopt;
+            }
+
+            // pack the 7-bit value blocks: 8 x 7 -> 4 x 14 -> 2 x 28 -> 1 x 56
+            auto result = word & 0x7f7f7f7f7f7f7f7fULL;
+            result = ((result & 0x7f007f007f007f00ULL) >> 1U) | (result & 0x007f007f007f007fULL);
+            result = ((result & 0x3fff00003fff0000ULL) >> 2U) | (result & 0x00003fff00003fffULL);
+            result = ((result & 0x0fffffff00000000ULL) >> 4U) | (result & 0x000000000fffffffULL);
+            iterator += length;
+            return { result };
+        }
+    }
+
+    std::uint64_t result {};
+    auto iter_work = iterator;
+    for (std::uint64_t i = 0; i < 8; ++i) {
+        if (iter_work == end) {
+            return std::nullopt;
+        }
+        auto group = static_cast<std::uint64_t>(static_cast<unsigned char>(*iter_work));
+        if (group == 0 && i != 0) {
+            // for strict, all zeros group is not allowed, except just represents 0
+            return std::nullopt;
+        }
+        ++iter_work;
+
+        // the 1st ~ 8th groups have continue bit.
+        // cvvv vvvv
+        //   c - continue bit
+        //   v - 7-bit value block
+        result |= (group & 0x7fULL) << (i * 7);
+        if ((group & 0x80ULL) == 0) {
+            // end of sequence
+            iterator = iter_work;
+            return { result };
+        }
+        // more groups are rest
+    }
+    if (iter_work == end) {
+        return std::nullopt;
+    }
+
+    auto group = static_cast<std::uint64_t>(static_cast<unsigned char>(*iter_work));
+    if (group == 0) {
+        // for strict, all zeros group is not allowed
+        return std::nullopt;
+    }
+    ++iter_work;
+
+    // the 9th group has no continue bit.
+    // vvvv vvvv
+    //   v - 8-bit value block
+    result |= (group & 0xffULL) << 56ULL;
+    iterator = iter_work;
+    return { result };
+}
+
+/**
+ * @brief restores the signed integer from its zigzag encoded form.
+ * @param encoded the encoded value
+ * @return the decoded value
+ */
+inline std::int64_t decode_zigzag(std::uint64_t encoded) noexcept {
+    std::uint64_t work = encoded;
+    work >>= 1ULL;
+    if ((encoded & 0x01ULL) != 0) {
+        work = ~work;
+    }
+    std::int64_t result {};
+    std::memcpy(&result, &work, sizeof(work));
+    return result;
+}
+
+} // namespace jogasaki::serializer::details
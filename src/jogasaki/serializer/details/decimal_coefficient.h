@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <boost/endian/conversion.hpp>
+
+#include <takatori/decimal/triple.h>
+
+#include "value_io_constants.h"
+
+namespace jogasaki::serializer::details {
+
+/**
+ * @brief the buffer for the coefficient octets of a decimal.
+ */
+using decimal_coefficient_buffer = std::array<char, max_decimal_coefficient_size>;
+
+/**
+ * @brief returns the number of significant bits of the value.
+ */
+inline std::size_t bit_width(unsigned __int128 value) noexcept {
+    auto high = static_cast<std::uint64_t>(value >> 64U);
+    if (high != 0) {
+        return 128U - static_cast<std::size_t>(__builtin_clzll(high));
+    }
+    auto low = static_cast<std::uint64_t>(value);
+    if (low != 0) {
+        return 64U - static_cast<std::size_t>(__builtin_clzll(low));
+    }
+    return 0;
+}
+
+/**
+ * @brief encodes the coefficient of the decimal into two's complement big-endian octets of the minimum length.
+ * @param value the decimal
+ * @param buffer the buffer to store the octets
+ * @return the octets, which are in the tail of the buffer
+ */
+inline std::string_view encode_decimal_coefficient(
+        takatori::decimal::triple value,
+        decimal_coefficient_buffer& buffer) noexcept {
+    auto magnitude = (static_cast<unsigned __int128>(value.coefficient_high()) << 64U) | value.coefficient_low();
+    bool negative = value.sign() < 0 && magnitude != 0;
+
+    // the coefficient is in (-2^128, 2^128), so the sign takes the 17th octet
+    auto bits = negative ? -magnitude : magnitude;
+    auto high = boost::endian::native_to_big(static_cast<std::uint64_t>(bits >> 64U));
+    auto low = boost::endian::native_to_big(static_cast<std::uint64_t>(bits));
+    buffer[0] = static_cast<char>(negative ? 0xffU : 0x00U);
+    std::memcpy(&buffer[1], &high, sizeof(high));
+    std::memcpy(&buffer[1 + sizeof(high)], &low, sizeof(low));
+
+    // -m takes as many bits as m - 1 does, and one more bit for the sign
+    auto size = bit_width(negative ? magnitude - 1 : magnitude) / 8U + 1U;
+    return { buffer.data() + (buffer.size() - size), size };
+}
+
+/**
+ * @brief decodes the decimal from its coefficient octets in two's complement big-endian.
+ * @param coefficient the octets, whose size must be in [1, max_decimal_coefficient_size]
+ * @param exponent the exponent of the decimal
+ * @return the decimal
+ */
+inline takatori::decimal::triple decode_decimal_coefficient(
+        std::string_view coefficient,
+        std::int32_t exponent) noexcept {
+    bool negative = (static_cast<std::uint8_t>(coefficient[0]) & 0x80U) != 0;
+
+    // sign extension to 16 octets, the 17th one being only the sign
+    std::array<char, sizeof(std::uint64_t) * 2> octets{};
+    auto size = std::min(coefficient.size(), octets.size());
+    std::memset(octets.data(), negative ? 0xff : 0x00, octets.size() - size);
+    std::memcpy(octets.data() + (octets.size() - size), coefficient.data() + (coefficient.size() - size), size);
+
+    std::uint64_t high{};
+    std::uint64_t low{};
+    std::memcpy(&high, octets.data(), sizeof(high));
+    std::memcpy(&low, octets.data() + sizeof(high), sizeof(low));
+    auto bits = (static_cast<unsigned __int128>(boost::endian::big_to_native(high)) << 64U)
+            | boost::endian::big_to_native(low);
+    auto magnitude = negative ? -bits : bits;
+    return takatori::decimal::triple {
+        negative ? -1 : +1,
+        static_cast<std::uint64_t>(magnitude >> 64U),
+        static_cast<std::uint64_t>(magnitude),
+        exponent,
+    };
+}
+
+} // namespace jogasaki::serializer::details
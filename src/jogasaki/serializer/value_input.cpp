@@ -4,7 +4,9 @@
 #include <limits>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
 
 #include <takatori/datetime/time_interval.h>
 #include <takatori/util/basic_buffer_view.h>
@@ -16,6 +18,8 @@
 #include <jogasaki/serializer/value_input_exception.h>
 
 #include "base128v.h"
+#include "details/base128v_decoder.h"
+#include "details/decimal_coefficient.h"
 #include "details/value_io_constants.h"
 
 namespace jogasaki::serializer {
@@ -57,14 +61,14 @@ static std::optional<T> extract(
 }
 
 static std::int64_t read_sint(buffer_view::const_iterator& position, buffer_view::const_iterator end) {
-    if (auto result = base128v::read_signed(position, end)) {
-        return *result;
+    if (auto result = decode_unsigned(position, end)) {
+        return decode_zigzag(*result);
     }
     throw_buffer_underflow();
 }
 
 static std::uint64_t read_uint(buffer_view::const_iterator& position, buffer_view::const_iterator end) {
-    if (auto result = base128v::read_unsigned(position, end)) {
+    if (auto result = decode_unsigned(position, end)) {
         return *result;
     }
     throw_buffer_underflow();
@@ -106,12 +110,9 @@ static T read_fixed(buffer_view::const_iterator& position, buffer_view::const_it
         throw_buffer_underflow();
     }
     T result { 0 };
-    for (std::size_t i = 1; i <= sizeof(T); ++i) {
-        T value { static_cast<unsigned char>(*position) };
-        result |= value << ((sizeof(T) - i) * 8U);
-        ++position;
-    }
-    return result;
+    std::memcpy(&result, &*position, sizeof(T));
+    position += sizeof(T);
+    return boost::endian::big_to_native(result);
 }
 
 void read_end_of_contents(buffer_view::const_iterator& position, buffer_view::const_iterator end) {
@@ -293,59 +294,8 @@ takatori::decimal::triple read_decimal(buffer_view::const_iterator& position, bu
     auto exponent = read_sint32(iter, end);
     auto coefficient = read_decimal_coefficient(iter, end);
 
-    // extract lower 8-octets of coefficient
-    std::uint64_t c_lo {};
-    std::uint64_t shift {};
-    for (
-            std::size_t offset = 0;
-            offset < coefficient.size() && offset < sizeof(std::uint64_t);
-            ++offset) {
-        auto pos = coefficient.size() - offset - 1;
-        std::uint64_t octet { static_cast<std::uint8_t>(coefficient[pos]) };
-        c_lo |= octet << shift;
-        shift += 8;
-    }
-
-    // extract upper 8-octets of coefficient
-    std::uint64_t c_hi {};
-    shift = 0;
-    for (
-            std::size_t offset = sizeof(std::uint64_t);
-            offset < coefficient.size() && offset < sizeof(std::uint64_t) * 2;
-            ++offset) {
-        auto pos = coefficient.size() - offset - 1;
-        std::uint64_t octet { static_cast<std::uint8_t>(coefficient[pos]) };
-        c_hi |= octet << shift;
-        shift += 8;
-    }
-
-    bool negative = (static_cast<std::uint8_t>(coefficient[0]) & 0x80U) != 0;
-
-    if (negative) {
-        // sign extension
-        if (coefficient.size() < sizeof(std::uint64_t) * 2) {
-            BOOST_ASSERT(coefficient.size() >= sizeof(std::uint64_t)); // NOLINT
-            auto mask = std::numeric_limits<std::uint64_t>::max(); // 0xfff.....
-            std::size_t rest = (coefficient.size() - sizeof(std::uint64_t)) * 8U;
-            c_hi |= mask << rest;
-        }
-
-        c_lo = ~c_lo + 1;
-        c_hi = ~c_hi;
-        if (c_lo == 0) {
-            c_hi += 1; // carry up
-        }
-        // if negative, coefficient must not be zero
-        BOOST_ASSERT(c_lo != 0 || c_hi != 0); // NOLINT
-    }
-
     position = iter;
-    return takatori::decimal::triple {
-        negative ? -1 : +1,
-        c_hi,
-        c_lo,
-        exponent,
-    };
+    return decode_decimal_coefficient({ coefficient.data(), coefficient.size() }, exponent);
 }
 
 std::string_view read_character(buffer_view::const_iterator& position, buffer_view::const_iterator end) {
@@ -557,4 +507,157 @@ std::tuple<std::uint64_t, std::uint64_t, std::uint64_t> read_clob(buffer_view::c
     };
 }
 
+std::size_t read_ints(
+        buffer_view::const_iterator& position,
+        buffer_view::const_iterator end,
+        std::int64_t* values,
+        std::size_t count) {
+    std::size_t i = 0;
+    for (; i < count && position != end; ++i) {
+        std::uint32_t head = static_cast<unsigned char>(*position);
+        if (head <= header_embed_positive_int + mask_embed_positive_int) {
+            values[i] = static_cast<std::int64_t>(head - header_embed_positive_int) + min_embed_positive_int_value;  // NOLINT
+            ++position;
+        } else if (header_embed_negative_int <= head && head <= header_embed_negative_int + mask_embed_negative_int) {
+            values[i] = static_cast<std::int64_t>(head - header_embed_negative_int) + min_embed_negative_int_value;  // NOLINT
+            ++position;
+        } else if (head == header_int) {
+            buffer_view::const_iterator iter = position;
+            ++iter;
+            values[i] = read_sint(iter, end);  // NOLINT
+            position = iter;
+        } else {
+            break;
+        }
+    }
+    return i;
+}
+
+template<class T, std::uint32_t Header>
+static std::size_t read_floats(
+        buffer_view::const_iterator& position,
+        buffer_view::const_iterator end,
+        T* values,
+        std::size_t count) {
+    using bits_type = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+    std::size_t i = 0;
+    for (; i < count && position != end; ++i) {
+        if (static_cast<unsigned char>(*position) != Header) {
+            break;
+        }
+        buffer_view::const_iterator iter = position;
+        ++iter;
+        auto bits = read_fixed<bits_type>(iter, end);
+        std::memcpy(&values[i], &bits, sizeof(T));  // NOLINT
+        position = iter;
+    }
+    return i;
+}
+
+std::size_t read_float4s(
+        buffer_view::const_iterator& position,
+        buffer_view::const_iterator end,
+        float* values,
+        std::size_t count) {
+    return read_floats<float, header_float4>(position, end, values, count);
+}
+
+std::size_t read_float8s(
+        buffer_view::const_iterator& position,
+        buffer_view::const_iterator end,
+        double* values,
+        std::size_t count) {
+    return read_floats<double, header_float8>(position, end, values, count);
+}
+
+static void skip_bytes(
+        std::size_t size,
+        buffer_view::const_iterator& position,
+        buffer_view::const_iterator end) {
+    if (std::distance(position, end) < static_cast<buffer_view::difference_type>(size)) {
+        throw_buffer_underflow();
+    }
+    position += size;
+}
+
+static void skip_varint(buffer_view::const_iterator& position, buffer_view::const_iterator end) {
+    // the 1st ~ 8th groups have continue bit, and the 9th group has no continue bit
+    for (std::uint64_t i = 0; i < 8; ++i) {
+        if (position == end) {
+            throw_buffer_underflow();
+        }
+        if ((static_cast<unsigned char>(*position++) & 0x80U) == 0) {
+            return;
+        }
+    }
+    skip_bytes(1, position, end);
+}
+
+static void skip_varints(std::size_t count, buffer_view::const_iterator& position, buffer_view::const_iterator end) {
+    for (std::size_t i = 0; i < count; ++i) {
+        skip_varint(position, end);
+    }
+}
+
+static void skip_entries(std::size_t count, buffer_view::const_iterator& position, buffer_view::const_iterator end) {
+    for (std::size_t i = 0; i < count; ++i) {
+        skip(position, end);
+    }
+}
+
+void skip(buffer_view::const_iterator& position, buffer_view::const_iterator end) {
+    if (position == end) {
+        throw_buffer_underflow();
+    }
+    buffer_view::const_iterator iter = position;
+    std::uint32_t head = static_cast<unsigned char>(*iter);
+    ++iter;
+
+    if (head <= header_embed_positive_int + mask_embed_positive_int) {
+        // embedded value
+    } else if (head <= header_embed_character + mask_embed_character) {
+        skip_bytes(head - header_embed_character + min_embed_character_size, iter, end);
+    } else if (head <= header_embed_row + mask_embed_row) {
+        skip_entries(head - header_embed_row + min_embed_row_size, iter, end);
+    } else if (head <= header_embed_array + mask_embed_array) {
+        skip_entries(head - header_embed_array + min_embed_array_size, iter, end);
+    } else if (head <= header_embed_negative_int + mask_embed_negative_int) {
+        // embedded value
+    } else if (head <= header_embed_octet + mask_embed_octet) {
+        skip_bytes(head - header_embed_octet + min_embed_octet_size, iter, end);
+    } else if (head <= header_embed_bit + mask_embed_bit) {
+        skip_bytes((head - header_embed_bit + min_embed_bit_size + 7) / 8, iter, end);
+    } else {
+        switch (head) {
+            case header_unknown: break;
+            case header_int: skip_varint(iter, end); break;
+            case header_float4: skip_bytes(sizeof(std::uint32_t), iter, end); break;
+            case header_float8: skip_bytes(sizeof(std::uint64_t), iter, end); break;
+            case header_decimal_compact: skip_varints(2, iter, end); break;
+            case header_decimal:
+                skip_varint(iter, end);
+                skip_bytes(read_uint(iter, end), iter, end);
+                break;
+            case header_character: skip_bytes(read_size(iter, end), iter, end); break;
+            case header_octet: skip_bytes(read_size(iter, end), iter, end); break;
+            case header_bit: skip_bytes((read_size(iter, end) + 7) / 8, iter, end); break;
+            case header_date: skip_varint(iter, end); break;
+            case header_time_of_day: skip_varint(iter, end); break;
+            case header_time_of_day_with_offset: skip_varints(2, iter, end); break;
+            case header_time_point: skip_varints(2, iter, end); break;
+            case header_time_point_with_offset: skip_varints(3, iter, end); break;
+            case header_datetime_interval: skip_varints(4, iter, end); break;
+            case header_row: skip_entries(read_size(iter, end), iter, end); break;
+            case header_array: skip_entries(read_size(iter, end), iter, end); break;
+            case header_clob: skip_bytes(sizeof(std::uint64_t) * 3, iter, end); break;
+            case header_blob: skip_bytes(sizeof(std::uint64_t) * 3, iter, end); break;
+            case header_end_of_contents: break;
+
+            default:
+                throw_unrecognized_entry(head);
+        }
+    }
+    position = iter;
+}
+
 } // namespace jogasaki::serializer
@@ -270,4 +270,52 @@ std::tuple<std::uint64_t, std::uint64_t, std::uint64_t> read_blob(buffer_view::c
  */
 std::tuple<std::uint64_t, std::uint64_t, std::uint64_t> read_clob(buffer_view::const_iterator& position, buffer_view::const_iterator end);
 
+/**
+ * @brief retrieves a run of `int` entries on the current position.
+ * @details this stops at the first entry of another type, including `null`, leaving the position on it,
+ *    so that the caller can retrieve it by another function and resume.
+ * @param position the buffer content iterator
+ * @param end the buffer ending position
+ * @param values the array to store the retrieved values
+ * @param count the maximum number of entries to retrieve
+ * @return the number of entries retrieved
+ * @throw value_input_exception if an entry exceeds the buffer
+ */
+std::size_t read_ints(
+        buffer_view::const_iterator& position,
+        buffer_view::const_iterator end,
+        std::int64_t* values,
+        std::size_t count);
+
+/**
+ * @brief retrieves a run of `float4` entries on the current position.
+ * @copydetails read_ints()
+ */
+std::size_t read_float4s(
+        buffer_view::const_iterator& position,
+        buffer_view::const_iterator end,
+        float* values,
+        std::size_t count);
+
+/**
+ * @brief retrieves a run of `float8` entries on the current position.
+ * @copydetails read_ints()
+ */
+std::size_t read_float8s(
+        buffer_view::const_iterator& position,
+        buffer_view::const_iterator end,
+        double* values,
+        std::size_t count);
+
+/**
+ * @brief skips the entry on the current position without decoding its value.
+ * @details the entry is passed over by its header and length prefix only, so that its contents are not validated.
+ *    Rows and arrays are skipped together with their elements.
+ *    This operation only advances the buffer iterator if it is successfully completed.
+ * @param position the buffer content iterator
+ * @param end the buffer ending position
+ * @throw value_input_exception if the entry is not supported or it exceeds the buffer
+ */
+void skip(buffer_view::const_iterator& position, buffer_view::const_iterator end);
+
 } // namespace jogasaki::serializer
@@ -28,27 +28,95 @@
 #include "ogawayama/transport/tsurugi_error.h"
 #include "transactionImpl.h"
 #include "result_setImpl.h"
+#include "deferred_completion.h"
 #include "prepared_statementImpl.h"
 #include "search_path_adapter.h"
 #include "table_list_adapter.h"
 #include "table_metadata_adapter.h"
 
+#include "connection_pool.h"
 #include "connectionImpl.h"
 
 namespace ogawayama::stub {
 
-Connection::Impl::Impl(Stub::Impl* manager, std::string_view session_id, std::size_t pgprocno, tateyama::authentication::credential_handler& credential_handler)
-    : manager_(manager), session_id_(session_id), wire_(session_id_), transport_(wire_, credential_handler), pgprocno_(pgprocno) {}
+static tateyama::common::wire::wait_strategy wait_strategy_of(const boost::property_tree::ptree& option) {
+    tateyama::common::wire::wait_strategy strategy{};
+    if (auto spin_count = option.get_optional<std::uint32_t>(WAIT_SPIN_COUNT); spin_count) {
+        strategy.spin_count = spin_count.value();
+    }
+    if (auto yield_count = option.get_optional<std::uint32_t>(WAIT_YIELD_COUNT); yield_count) {
+        strategy.yield_count = yield_count.value();
+    }
+    return strategy;
+}
+
+static tateyama::common::wire::slot_policy slot_policy_of(const boost::property_tree::ptree& option) {
+    tateyama::common::wire::slot_policy policy{};
+    if (auto count = option.get_optional<std::size_t>(SLOT_COUNT); count) {
+        policy.count = count.value();
+    }
+    if (auto blocking = option.get_optional<bool>(SLOT_BLOCKING); blocking) {
+        policy.blocking = blocking.value();
+    }
+    if (auto timeout = option.get_optional<std::uint64_t>(SLOT_TIMEOUT); timeout) {
+        policy.timeout = std::chrono::milliseconds(timeout.value());
+    }
+    return policy;
+}
+
+static tateyama::common::wire::receive_mode receive_mode_of(const boost::property_tree::ptree& option) {
+    if (auto dispatcher = option.get_optional<bool>(RESPONSE_DISPATCHER); dispatcher && dispatcher.value()) {
+        return tateyama::common::wire::receive_mode::dispatcher;
+    }
+    return tateyama::common::wire::receive_mode::leader_election;
+}
+
+Connection::Impl::Impl(Stub::Impl* manager, std::string_view session_id, std::size_t pgprocno, tateyama::authentication::credential_handler& credential_handler, const boost::property_tree::ptree& option)
+    : manager_(manager), session_id_(session_id), wire_(session_id_, wait_strategy_of(option), slot_policy_of(option), receive_mode_of(option)), transport_(wire_, credential_handler), pgprocno_(pgprocno) {
+    if (auto mirroring = option.get_optional<bool>(RESULTSET_MIRRORING); mirroring) {
+        wire_.set_resultset_mirroring(mirroring.value());
+    }
+    if (auto deferred = option.get_optional<bool>(DEFERRED_DISPOSAL); deferred && deferred.value()) {
+        disposal_queue_ = std::make_unique<disposal_queue>(transport_, option.get<std::size_t>(DISPOSAL_QUEUE_SIZE, disposal_queue::default_capacity));
+        transport_.set_slot_shortage_handler([this](){ disposal_queue_->flush(); });
+    }
+}
 
 Connection::Impl::~Impl()
 {
     try {
+        flush_disposal_queue();
+        transport_.set_slot_shortage_handler({});  // disposal_queue_ is destroyed before transport_
         transport_.close();
     } catch (std::exception &ex) {
         std::cerr << ex.what() << std::endl;
     }
 }
 
+bool Connection::Impl::is_alive()
+{
+    if (auto err = wire_.get_status_provider().is_alive(); !err.empty()) {
+        std::cerr << err << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Connection::Impl::reset()
+{
+    try {
+        flush_disposal_queue();
+        if (!wire_.is_idle()) {
+            return false;
+        }
+        transport_.last_sql_error().Clear();
+        return true;
+    } catch (std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        return false;
+    }
+}
+
 ErrorCode Connection::Impl::hello()
 {
     return ErrorCode::OK;  // FIXME check whther connection is OK
@@ -57,6 +125,7 @@ ErrorCode Connection::Impl::hello()
 ErrorCode Connection::Impl::begin(TransactionPtr& transaction)
 {
     try {
+        flush_disposal_queue();
         ::jogasaki::proto::sql::request::Begin request{};
 
         auto response_opt = transport_.send(request);
@@ -123,6 +192,7 @@ ErrorCode Connection::Impl::begin(const boost::property_tree::ptree& option, Tra
     }
 
     try {
+        flush_disposal_queue();
         auto response_opt = transport_.send(request);
         if (!response_opt) {
             return ErrorCode::SERVER_FAILURE;
@@ -138,10 +208,8 @@ ErrorCode Connection::Impl::begin(const boost::property_tree::ptree& option, Tra
     }
 }
 
-ErrorCode Connection::Impl::prepare(std::string_view sql, const placeholders_type& placeholders, PreparedStatementPtr& prepared)
+static ErrorCode build_prepare(::jogasaki::proto::sql::request::Prepare& request, std::string_view sql, const placeholders_type& placeholders)
 {
-    ::jogasaki::proto::sql::request::Prepare request{};
-
     std::string sql_string(sql);
     request.set_sql(sql_string);
 
@@ -190,6 +258,16 @@ ErrorCode Connection::Impl::prepare(std::string_view sql, const placeholders_typ
         }
     }
 
+    return ErrorCode::OK;
+}
+
+ErrorCode Connection::Impl::prepare(std::string_view sql, const placeholders_type& placeholders, PreparedStatementPtr& prepared)
+{
+    ::jogasaki::proto::sql::request::Prepare request{};
+    if (auto rv = build_prepare(request, sql, placeholders); rv != ErrorCode::OK) {
+        return rv;
+    }
+
     try {
         auto response_opt = transport_.send(request);
         if (!response_opt) {
@@ -200,7 +278,7 @@ ErrorCode Connection::Impl::prepare(std::string_view sql, const placeholders_typ
             auto& psh = response_prepare.prepared_statement_handle();
             std::size_t id = psh.handle();
             bool has_result_records = psh.has_result_records();
-            prepared = std::make_unique<PreparedStatement>(std::make_unique<PreparedStatement::Impl>(this, id, has_result_records));
+            prepared = std::make_unique<PreparedStatement>(std::make_unique<PreparedStatement::Impl>(this, id, has_result_records, placeholders));
             return ErrorCode::OK;
         }
         return ErrorCode::SERVER_ERROR;
@@ -209,6 +287,52 @@ ErrorCode Connection::Impl::prepare(std::string_view sql, const placeholders_typ
     }
 }
 
+std::future<ErrorCode> Connection::Impl::prepare_async(std::string_view sql, const placeholders_type& placeholders, PreparedStatementPtr& prepared)
+{
+    ::jogasaki::proto::sql::request::Prepare request{};
+    if (auto rv = build_prepare(request, sql, placeholders); rv != ErrorCode::OK) {
+        return make_ready(rv);
+    }
+
+    tateyama::common::wire::message_header::index_type slot_index{};
+    try {
+        if (auto res = transport_.post([&request](::jogasaki::proto::sql::request::Request& req) {
+                req.unsafe_arena_set_allocated_prepare(&request);
+            }, slot_index); !res) {
+            return make_ready(ErrorCode::SERVER_FAILURE);
+        }
+    } catch (std::runtime_error &e) {
+        return make_ready(ErrorCode::SERVER_ERROR);
+    }
+    // the placeholders given may be gone when the future is resolved
+    return make_deferred([this, slot_index, &prepared, placeholders = placeholders_type{placeholders}](bool deliver) {
+        try {
+            auto rv = transport_.complete(
+                [this, deliver, &prepared, &placeholders](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<ErrorCode> {
+                    if (!response_message.has_prepare()) {
+                        return std::nullopt;
+                    }
+                    const auto& response_prepare = response_message.prepare();
+                    transport_.set_sql_error(response_prepare);
+                    if (response_prepare.has_prepared_statement_handle()) {
+                        auto& psh = response_prepare.prepared_statement_handle();
+                        if (deliver) {
+                            prepared = std::make_unique<PreparedStatement>(std::make_unique<PreparedStatement::Impl>(this, psh.handle(), psh.has_result_records(), placeholders));
+                        }
+                        return ErrorCode::OK;
+                    }
+                    return ErrorCode::SERVER_ERROR;
+                }, slot_index);
+            if (!rv) {
+                return ErrorCode::SERVER_FAILURE;
+            }
+            return rv.value();
+        } catch (std::runtime_error &e) {
+            return ErrorCode::SERVER_ERROR;
+        }
+    });
+}
+
 ErrorCode Connection::Impl::get_table_metadata(const std::string& table_name, TableMetadataPtr& table_metadata)
 {
     try {
@@ -268,6 +392,16 @@ ErrorCode Connection::Impl::get_search_path(SearchPathPtr& sp) {
     }
 }
 
+ErrorCode Connection::Impl::get_wait_statistics(wait_statistics& statistics)
+{
+    const auto& counters = wire_.get_wait_statistics();
+    statistics.immediate = counters.immediate.load();
+    statistics.spin = counters.spin.load();
+    statistics.yield = counters.yield.load();
+    statistics.block = counters.block.load();
+    return ErrorCode::OK;
+}
+
 static inline bool handle_sql_error(ogawayama::stub::tsurugi_error_code& code, ::jogasaki::proto::sql::response::Error& sql_error) {
     if (auto itr = ogawayama::transport::error_map.find(sql_error.code()); itr != ogawayama::transport::error_map.end()) {
         code.type = tsurugi_error_code::tsurugi_error_type::sql_error;
@@ -328,7 +462,14 @@ Connection::Connection(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
 /**
  * @brief destructor of Connection class
  */
-Connection::~Connection() = default;
+Connection::~Connection()
+{
+    if (impl_) {
+        if (auto pool = impl_->get_pool(); pool) {
+            pool->release(std::move(impl_));
+        }
+    }
+}
 
 /**
  * @brief get transaction object, meaning transaction begin
@@ -345,6 +486,11 @@ ErrorCode Connection::begin(const boost::property_tree::ptree& option, Transacti
  */
 ErrorCode Connection::prepare(std::string_view sql, const placeholders_type& placeholders, PreparedStatementPtr &prepared) { return impl_->prepare(sql, placeholders, prepared); }
 
+/**
+ * @brief prepare a statement asynchronously
+ */
+std::future<ErrorCode> Connection::prepare_async(std::string_view sql, const placeholders_type& placeholders, PreparedStatementPtr &prepared) { return impl_->prepare_async(sql, placeholders, prepared); }
+
 /**
  * @brief get table metadata
  */
@@ -368,4 +514,12 @@ ErrorCode Connection::tsurugi_error(tsurugi_error_code& code)
     return impl_->tsurugi_error(code);
 }
 
+/**
+ * @brief get the counters of the waits for responses and records
+ */
+ErrorCode Connection::get_wait_statistics(wait_statistics& statistics)
+{
+    return impl_->get_wait_statistics(statistics);
+}
+
 }  // namespace ogawayama::stub
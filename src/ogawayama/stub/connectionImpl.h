@@ -15,9 +15,12 @@
  */
 #pragma once
 
+#include <memory>
+
 #include <ogawayama/stub/api.h>
 #include "ogawayama/stub/table_metadata_adapter.h"
 #include "ogawayama/transport/transport.h"
+#include "disposal_queue.h"
 
 namespace ogawayama::stub {
 
@@ -27,7 +30,7 @@ namespace ogawayama::stub {
 class Connection::Impl
 {
 public:
-    Impl(Stub::Impl*, std::string_view, std::size_t, tateyama::authentication::credential_handler&);
+    Impl(Stub::Impl*, std::string_view, std::size_t, tateyama::authentication::credential_handler&, const boost::property_tree::ptree&);
     ~Impl();
 
     Impl(const Impl&) = delete;
@@ -58,6 +61,14 @@ public:
      */
     ErrorCode prepare(std::string_view, const placeholders_type&, PreparedStatementPtr&);
 
+    /**
+     * @brief prepare statement asynchronously
+     * @param sql statement
+     * @param reference to a PreparedSatementPtr
+     * @return the future of the error code
+     */
+    std::future<ErrorCode> prepare_async(std::string_view, const placeholders_type&, PreparedStatementPtr&);
+
     /**
      * @brief get the error of the last SQL executed
      * @param code returns the error code reported by the tsurugidb
@@ -87,17 +98,62 @@ public:
      */
      ErrorCode get_search_path(SearchPathPtr& sp);
 
+    /**
+     * @brief get the counters of the waits for responses and records.
+     * @param statistics returns the number of waits resolved in each phase
+     * @return error code defined in error_code.h
+     */
+    ErrorCode get_wait_statistics(wait_statistics& statistics);
+
+    /**
+     * @brief get the queue of the cleanup requests whose responses are received later.
+     * @return the queue, nullptr unless the deferred disposal is enabled
+     */
+    disposal_queue* get_disposal_queue() { return disposal_queue_.get(); }
+
+    /**
+     * @brief check whether the server of the session is alive, by its status provider.
+     */
+    [[nodiscard]] bool is_alive();
+
+    /**
+     * @brief bring the session back to the state just after connected, for another Connection to use it.
+     * @return true if the session can be reused, false if a request is still in flight on it
+     */
+    [[nodiscard]] bool reset();
+
+    /**
+     * @brief set the pool which this session is returned to when the Connection is destructed.
+     */
+    void set_pool(std::weak_ptr<connection_pool> pool) { pool_ = std::move(pool); }
+
+    /**
+     * @brief get the pool which this session is returned to, nullptr unless it is taken from an open pool.
+     */
+    [[nodiscard]] std::shared_ptr<connection_pool> get_pool() const { return pool_.lock(); }
+
 private:
     Stub::Impl* manager_;
     std::string session_id_;
     tateyama::common::wire::session_wire_container wire_;
     tateyama::bootstrap::wire::transport transport_;
     std::size_t pgprocno_;
+    std::unique_ptr<disposal_queue> disposal_queue_{};
+    std::weak_ptr<connection_pool> pool_{};
 
     std::vector<ResultSet::Impl> result_sets_{};
 
     ErrorCode hello();
 
+    /**
+     * @brief receive the responses of the cleanup requests pending, if any, before a transaction begins.
+     */
+    void flush_disposal_queue() {
+        if (disposal_queue_) {
+            disposal_queue_->flush();
+        }
+    }
+
     friend class Stub::Impl;
 };
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "connectionImpl.h"
+#include "result_setImpl.h"
+#include "stubImpl.h"
+
+#include "connection_pool.h"
+
+namespace ogawayama::stub {
+
+connection_pool::connection_pool(Stub::Impl* stub, const boost::property_tree::ptree& pool_option, std::optional<Auth> auth, boost::property_tree::ptree option)
+    : stub_(stub),
+      min_size_(pool_option.get<std::size_t>(POOL_MIN_SIZE, 0)),
+      max_size_(pool_option.get<std::size_t>(POOL_MAX_SIZE, std::max(min_size_, default_max_size))),
+      idle_timeout_(pool_option.get<std::uint64_t>(POOL_IDLE_TIMEOUT, 0)),
+      auth_(std::move(auth)),
+      option_(std::move(option)) {
+    if (auth_) {
+        credential_handler_.set_user_password(auth_.value().user(), auth_.value().password());
+    }
+}
+
+connection_pool::~connection_pool() = default;
+
+bool connection_pool::is_valid_option(const boost::property_tree::ptree& pool_option) {
+    try {
+        auto min_size = pool_option.get<std::size_t>(POOL_MIN_SIZE, 0);
+        auto max_size = pool_option.get<std::size_t>(POOL_MAX_SIZE, std::max(min_size, default_max_size));
+        (void) pool_option.get<std::uint64_t>(POOL_IDLE_TIMEOUT, 0);
+        return max_size > 0 && min_size <= max_size;
+    } catch (boost::property_tree::ptree_error &e) {
+        return false;
+    }
+}
+
+ErrorCode connection_pool::fill() {
+    while (size() < min_size_) {
+        std::unique_ptr<Connection::Impl> impl{};
+        if (auto rc = connect(impl, 0); rc != ErrorCode::OK) {
+            return rc;
+        }
+        std::unique_lock<std::mutex> lock(mtx_);
+        idle_.emplace_back(entry{std::move(impl), clock::now()});
+    }
+    return ErrorCode::OK;
+}
+
+bool connection_pool::matches(const Auth* auth, const boost::property_tree::ptree& option) const {
+    if ((auth != nullptr) != auth_.has_value()) {
+        return false;
+    }
+    if (auth != nullptr && (auth->user() != auth_.value().user() || auth->password() != auth_.value().password())) {
+        return false;
+    }
+    return option == option_;
+}
+
+ErrorCode connection_pool::acquire(std::unique_ptr<Connection::Impl>& impl, std::size_t n) {
+    while (true) {
+        std::deque<entry> evicted{};
+        std::unique_ptr<Connection::Impl> candidate{};
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            evict(evicted);
+            if (!idle_.empty()) {
+                candidate = std::move(idle_.back().impl_);
+                idle_.pop_back();
+            }
+        }
+        evicted.clear();  // closes the sessions evicted out of the lock
+        if (!candidate) {
+            return connect(impl, n);
+        }
+        if (candidate->is_alive()) {
+            impl = std::move(candidate);
+            return ErrorCode::OK;
+        }
+    }
+}
+
+void connection_pool::release(std::unique_ptr<Connection::Impl> impl) {
+    if (!impl->reset()) {
+        return;
+    }
+    std::deque<entry> evicted{};
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        evict(evicted);
+        if (idle_.size() < max_size_) {
+            idle_.emplace_back(entry{std::move(impl), clock::now()});
+        }
+    }
+}
+
+std::size_t connection_pool::size() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    return idle_.size();
+}
+
+ErrorCode connection_pool::connect(std::unique_ptr<Connection::Impl>& impl, std::size_t n) {
+    auto rc = stub_->connect(impl, n, credential_handler_, option_);
+    if (rc == ErrorCode::OK) {
+        impl->set_pool(weak_from_this());
+    }
+    return rc;
+}
+
+void connection_pool::evict(std::deque<entry>& evicted) {
+    if (idle_timeout_.count() == 0) {
+        return;
+    }
+    auto deadline = clock::now() - idle_timeout_;
+    while (idle_.size() > min_size_ && idle_.front().released_ < deadline) {
+        evicted.emplace_back(std::move(idle_.front()));
+        idle_.pop_front();
+    }
+}
+
+}  // namespace ogawayama::stub
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include <ogawayama/stub/api.h>
+
+#include "tateyama/authentication/credential_handler.h"
+
+namespace ogawayama::stub {
+
+/**
+ * @brief the sessions handshaked in advance, which are lent to the Connections of a Stub and returned to be reused.
+ *  A session returned is reset, and closed instead of kept if it cannot be reset, or if the pool is full.
+ *  A session taken is checked whether the server is alive, and closed to take another if not.
+ *  The sessions idle longer than the idle timeout are closed when a session is taken or returned,
+ *  while more sessions than the minimum size are kept.
+ */
+class connection_pool : public std::enable_shared_from_this<connection_pool> {
+public:
+    /**
+     * @brief Construct a new object.
+     * @param stub the stub which connects the sessions
+     * @param pool_option the pool option, which must be valid
+     * @param auth the authentication information of the sessions, if any
+     * @param option the connection option of the sessions
+     */
+    connection_pool(Stub::Impl* stub, const boost::property_tree::ptree& pool_option, std::optional<Auth> auth, boost::property_tree::ptree option);
+    ~connection_pool();
+
+    connection_pool(const connection_pool&) = delete;
+    connection_pool& operator=(const connection_pool&) = delete;
+    connection_pool(connection_pool&&) = delete;
+    connection_pool& operator=(connection_pool&&) = delete;
+
+    /**
+     * @brief check whether the pool option is valid.
+     */
+    static bool is_valid_option(const boost::property_tree::ptree& pool_option);
+
+    /**
+     * @brief connect the sessions of the minimum size.
+     * @return error code defined in error_code.h
+     */
+    ErrorCode fill();
+
+    /**
+     * @brief check whether the connection requested is of the sessions in this pool.
+     * @param auth the authentication information requested, nullptr if none
+     * @param option the connection option requested
+     */
+    [[nodiscard]] bool matches(const Auth* auth, const boost::property_tree::ptree& option) const;
+
+    /**
+     * @brief take a session from the pool, or connect a new one if no session is available.
+     * @param impl returns the session
+     * @param n supposed to be given MyProc->pgprocno // obsolete
+     * @return error code defined in error_code.h
+     */
+    ErrorCode acquire(std::unique_ptr<Connection::Impl>& impl, std::size_t n);
+
+    /**
+     * @brief return the session to the pool.
+     * @param impl the session taken from this pool
+     */
+    void release(std::unique_ptr<Connection::Impl> impl);
+
+    /**
+     * @brief get the number of the sessions idle in the pool.
+     */
+    [[nodiscard]] std::size_t size();
+
+private:
+    using clock = std::chrono::steady_clock;
+    struct entry {
+        std::unique_ptr<Connection::Impl> impl_;
+        clock::time_point released_;
+    };
+
+    constexpr static std::size_t default_max_size = 4;
+
+    Stub::Impl* stub_;
+    std::size_t min_size_;
+    std::size_t max_size_;
+    std::chrono::milliseconds idle_timeout_;
+    std::optional<Auth> auth_;
+    boost::property_tree::ptree option_;
+    tateyama::authentication::credential_handler credential_handler_{};
+    std::deque<entry> idle_{};  // the most recently returned at the back
+    std::mutex mtx_{};
+
+    ErrorCode connect(std::unique_ptr<Connection::Impl>& impl, std::size_t n);
+    void evict(std::deque<entry>& evicted);
+};
+
+}  // namespace ogawayama::stub
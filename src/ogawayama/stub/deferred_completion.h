@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <exception>
+#include <future>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+#include <ogawayama/stub/error_code.h>
+
+namespace ogawayama::stub {
+
+/**
+ * @brief the completion of a request already sent, run when the future is resolved.
+ *  If the future is dropped without being resolved, the completion still runs
+ *  so that the response is received and its slot is released, but nothing is delivered to the caller.
+ * @tparam F the function taking bool, which is true if the result is to be delivered to the caller
+ */
+template <typename F>
+class deferred_completion {
+public:
+    explicit deferred_completion(F&& complete) : complete_(std::move(complete)) {}
+    ~deferred_completion() {
+        if (pending_) {
+            try {
+                (void) complete_(false);
+            } catch (std::exception &ex) {
+                std::cerr << ex.what() << std::endl;
+            }
+        }
+    }
+
+    deferred_completion(deferred_completion&& other) noexcept : complete_(std::move(other.complete_)), pending_(std::exchange(other.pending_, false)) {}
+    deferred_completion(const deferred_completion&) = delete;
+    deferred_completion& operator=(const deferred_completion&) = delete;
+    deferred_completion& operator=(deferred_completion&&) = delete;
+
+    ErrorCode operator()() {
+        pending_ = false;
+        return complete_(true);
+    }
+
+private:
+    F complete_;
+    bool pending_{true};
+};
+
+/**
+ * @brief make the future resolved by the completion on the thread calling get() or wait().
+ */
+template <typename F>
+std::future<ErrorCode> make_deferred(F&& complete) {
+    return std::async(std::launch::deferred, deferred_completion<std::decay_t<F>>(std::forward<F>(complete)));
+}
+
+/**
+ * @brief make the future already resolved, used when the request has not been sent.
+ */
+inline std::future<ErrorCode> make_ready(ErrorCode code) {
+    std::promise<ErrorCode> promise{};
+    promise.set_value(code);
+    return promise.get_future();
+}
+
+}  // namespace ogawayama::stub
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "disposal_queue.h"
+
+namespace ogawayama::stub {
+
+disposal_queue::disposal_queue(tateyama::bootstrap::wire::transport& transport, std::size_t capacity)
+    : transport_(transport), capacity_(std::max(capacity, static_cast<std::size_t>(1))) {
+}
+
+void disposal_queue::rollback(const ::jogasaki::proto::sql::common::Transaction& transaction_handle) {
+    post(kind::rollback, transaction_handle);
+}
+
+void disposal_queue::dispose(const ::jogasaki::proto::sql::common::Transaction& transaction_handle) {
+    post(kind::dispose, transaction_handle);
+}
+
+void disposal_queue::receive_body(tateyama::common::wire::message_header::index_type slot_index) {
+    make_room();
+    entries_.emplace_back(entry{kind::body, slot_index, {}});
+}
+
+void disposal_queue::flush() {
+    // the entries can be added by complete(), so they are taken one by one
+    while (!entries_.empty()) {
+        auto e = std::move(entries_.front());
+        entries_.pop_front();
+        try {
+            complete(e);
+        } catch (std::exception &ex) {  // a cleanup failed must not fail the request flushing the queue
+            std::cerr << "cannot receive the response of the cleanup request: " << ex.what() << std::endl;
+        }
+    }
+}
+
+void disposal_queue::post(kind k, const ::jogasaki::proto::sql::common::Transaction& transaction_handle) {
+    make_room();
+    tateyama::common::wire::message_header::index_type slot_index{};
+    auto builder = [k, &transaction_handle](::jogasaki::proto::sql::request::Request& request) {
+        if (k == kind::rollback) {
+            *(request.mutable_rollback()->mutable_transaction_handle()) = transaction_handle;
+        } else {
+            *(request.mutable_dispose_transaction()->mutable_transaction_handle()) = transaction_handle;
+        }
+    };
+    try {
+        // a request finding no free slot flushes the queue through the slot shortage handler of the transport
+        if (!transport_.post(builder, slot_index)) {
+            std::cerr << "cannot send the request to clean up the transaction" << std::endl;
+            return;
+        }
+    } catch (std::runtime_error &ex) {
+        std::cerr << "cannot send the request to clean up the transaction: " << ex.what() << std::endl;
+        return;
+    }
+    entries_.emplace_back(entry{k, slot_index, transaction_handle});
+}
+
+void disposal_queue::make_room() {
+    if (entries_.size() >= capacity_) {
+        flush();
+    }
+}
+
+void disposal_queue::complete(entry& e) {
+    switch (e.kind_) {
+    case kind::rollback:
+    {
+        auto rv = transport_.complete(
+            [](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<bool> {
+                if (response_message.has_result_only()) {
+                    return response_message.result_only().has_success();
+                }
+                return std::nullopt;
+            }, e.slot_index_);
+        if (rv && rv.value()) {
+            post(kind::dispose, e.transaction_handle_);
+            return;
+        }
+        std::cerr << "the rollback of a transaction abandoned failed" << std::endl;
+        return;
+    }
+    case kind::dispose:
+    {
+        auto rv = transport_.complete(
+            [](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<bool> {
+                if (response_message.has_dispose_transaction()) {
+                    return response_message.dispose_transaction().has_success();
+                }
+                return response_message.has_result_only() && response_message.result_only().has_success();
+            }, e.slot_index_);
+        if (!rv || !rv.value()) {
+            std::cerr << "the disposal of a transaction failed" << std::endl;
+        }
+        return;
+    }
+    case kind::body:
+        if (auto body_opt = transport_.receive_body(e.slot_index_); !body_opt) {
+            std::cerr << "error at " << __func__ << std::endl;
+        }
+        return;
+    }
+}
+
+}  // namespace ogawayama::stub
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <deque>
+
+#include <jogasaki/proto/sql/common.pb.h>
+
+#include "ogawayama/transport/transport.h"
+
+namespace ogawayama::stub {
+
+/**
+ * @brief the requests to clean up transactions and result sets, whose responses are received later.
+ *  Each cleanup request is sent when it is queued, and its response is received when the queue is flushed,
+ *  which is done before the next transaction begins, when the queue is full, when a request finds no free slot,
+ *  and when the connection is closed.
+ *  The DisposeTransaction following a Rollback is sent when the response of the Rollback is received.
+ *  The errors of the cleanup are only reported to std::cerr, as nobody waits for them.
+ */
+class disposal_queue {
+public:
+    /**
+     * @brief the number of the cleanup requests that can be pending at once, unless specified.
+     */
+    static constexpr std::size_t default_capacity = 4;
+
+    /**
+     * @brief Construct a new object.
+     * @param transport the transport of the connection
+     * @param capacity the number of the cleanup requests that can be pending at once
+     */
+    disposal_queue(tateyama::bootstrap::wire::transport& transport, std::size_t capacity);
+
+    /**
+     * @brief roll back the transaction and then dispose it.
+     * @param transaction_handle the transaction abandoned
+     */
+    void rollback(const ::jogasaki::proto::sql::common::Transaction& transaction_handle);
+
+    /**
+     * @brief dispose the transaction already committed or rolled back.
+     * @param transaction_handle the transaction finished
+     */
+    void dispose(const ::jogasaki::proto::sql::common::Transaction& transaction_handle);
+
+    /**
+     * @brief receive the body response of the query whose result set has been closed.
+     * @param slot_index the slot index of the query
+     */
+    void receive_body(tateyama::common::wire::message_header::index_type slot_index);
+
+    /**
+     * @brief receive the responses of all the cleanup requests pending.
+     *  An error in receiving one of them is reported to std::cerr and does not stop the others.
+     */
+    void flush();
+
+    /**
+     * @brief get the number of the cleanup requests pending.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+
+private:
+    enum class kind { rollback, dispose, body };
+    struct entry {
+        kind kind_;
+        tateyama::common::wire::message_header::index_type slot_index_;
+        ::jogasaki::proto::sql::common::Transaction transaction_handle_;
+    };
+
+    tateyama::bootstrap::wire::transport& transport_;
+    std::size_t capacity_;
+    std::deque<entry> entries_{};
+
+    void post(kind k, const ::jogasaki::proto::sql::common::Transaction& transaction_handle);
+    void make_room();
+    void complete(entry& e);
+};
+
+}  // namespace ogawayama::stub
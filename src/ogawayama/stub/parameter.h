@@ -0,0 +1,95 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <jogasaki/proto/sql/request.pb.h>
+#include <jogasaki/serializer/details/decimal_coefficient.h>
+
+#include "ogawayama/stub/api.h"
+
+namespace ogawayama::stub {
+
+/**
+ * @brief sets the value of a parameter, used as the visitor of value_type.
+ */
+class parameter {
+public:
+    explicit parameter(::jogasaki::proto::sql::request::Parameter* parameter) : parameter_(parameter) {}
+    parameter(::jogasaki::proto::sql::request::Parameter* parameter, const std::string& name) : parameter_(parameter) {
+        parameter_->set_name(name);
+    }
+    void operator()(const std::monostate& data) {
+    }
+    void operator()(const std::int32_t& data) {
+        parameter_->set_int4_value(data);
+    }
+    void operator()(const std::int64_t& data) {
+        parameter_->set_int8_value(data);
+    }
+    void operator()(const float& data) {
+        parameter_->set_float4_value(data);
+    }
+    void operator()(const double& data) {
+        parameter_->set_float8_value(data);
+    }
+    void operator()(const std::string& data) {
+        parameter_->set_character_value(data);
+    }
+    void operator()(std::string_view data) {
+        parameter_->set_character_value(data.data(), data.size());
+    }
+    void operator()(const binary_type& data) {
+        parameter_->set_octet_value(reinterpret_cast<const char*>(data.data()), data.size());  //  NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+    void operator()(const date_type& data) {
+        parameter_->set_date_value(data.days_since_epoch());
+    }
+    void operator()(const time_type& data) {
+        parameter_->set_time_of_day_value(data.time_since_epoch().count());
+    }
+    void operator()(const timestamp_type& data) {
+        auto v = parameter_->mutable_time_point_value();
+        v->set_offset_seconds(data.seconds_since_epoch().count());
+        v->set_nano_adjustment(data.subsecond().count());
+    }
+    void operator()(const timetz_type& data) {
+        auto v = parameter_->mutable_time_of_day_with_time_zone_value();
+        v->set_time_zone_offset(data.second);
+        v->set_offset_nanoseconds(data.first.time_since_epoch().count());
+    }
+    void operator()(const timestamptz_type& data) {
+        auto v = parameter_->mutable_time_point_with_time_zone_value();
+        v->set_time_zone_offset(data.second);
+        v->set_offset_seconds(data.first.seconds_since_epoch().count());
+        v->set_nano_adjustment(data.first.subsecond().count());
+    }
+
+    void operator()(const decimal_type& triple) {
+        jogasaki::serializer::details::decimal_coefficient_buffer buffer{};
+        auto coefficient = jogasaki::serializer::details::encode_decimal_coefficient(triple, buffer);
+        auto *decimal = parameter_->mutable_decimal_value();
+        decimal->set_unscaled_value(coefficient.data(), coefficient.size());
+        decimal->set_exponent(triple.exponent());
+    }
+
+private:
+    ::jogasaki::proto::sql::request::Parameter* parameter_;
+};
+
+}  // namespace ogawayama::stub
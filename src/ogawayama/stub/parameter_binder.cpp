@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "parameter_binderImpl.h"
+
+namespace ogawayama::stub {
+
+ParameterBinder::Impl::Impl(PreparedStatement::Impl* prepared)
+    : has_result_records_(prepared->has_result_records()),
+      parameters_(has_result_records_ ? query_.mutable_parameters() : statement_.mutable_parameters()) {
+    auto* handle = has_result_records_ ? query_.mutable_prepared_statement_handle() : statement_.mutable_prepared_statement_handle();
+    handle->set_handle(prepared->get_id());
+    handle->set_has_result_records(has_result_records_);
+
+    const auto& placeholders = prepared->placeholders();
+    parameters_->Reserve(static_cast<int>(placeholders.size()));
+    for (auto& e : placeholders) {
+        parameters_->Add()->set_name(e.first);
+    }
+}
+
+/**
+ * @brief constructor of ParameterBinder class
+ */
+ParameterBinder::ParameterBinder(PreparedStatementPtr& prepared_statement)
+    : impl_(std::make_unique<ParameterBinder::Impl>(prepared_statement->get_impl())) {}
+
+/**
+ * @brief destructor of ParameterBinder class
+ */
+ParameterBinder::~ParameterBinder() = default;
+
+std::size_t ParameterBinder::size() const noexcept { return impl_->size(); }
+
+ErrorCode ParameterBinder::set(std::size_t index, std::int32_t value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, std::int64_t value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, float value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, double value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, std::string_view value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, const binary_type& value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, date_type value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, time_type value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, timestamp_type value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, const timetz_type& value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, const timestamptz_type& value) { return impl_->set(index, value); }
+ErrorCode ParameterBinder::set(std::size_t index, const decimal_type& value) { return impl_->set(index, value); }
+
+ErrorCode ParameterBinder::set_null(std::size_t index) {
+    auto* p = impl_->parameter(index);
+    if (p == nullptr) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    p->clear_value();
+    return ErrorCode::OK;
+}
+
+void ParameterBinder::clear() noexcept { impl_->clear(); }
+
+}  // namespace ogawayama::stub
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <jogasaki/proto/sql/request.pb.h>
+
+#include "ogawayama/stub/api.h"
+#include "parameter.h"
+#include "prepared_statementImpl.h"
+
+namespace ogawayama::stub {
+
+/**
+ * @brief constructor of ParameterBinder::Impl class
+ */
+class ParameterBinder::Impl
+{
+public:
+    explicit Impl(PreparedStatement::Impl* prepared);
+
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(parameters_->size()); }
+
+    [[nodiscard]] bool has_result_records() const noexcept { return has_result_records_; }
+
+    /**
+     * @brief get the parameter at the position
+     * @return the parameter, nullptr if the position is out of range
+     */
+    ::jogasaki::proto::sql::request::Parameter* parameter(std::size_t index) {
+        if (index >= size()) {
+            return nullptr;
+        }
+        return parameters_->Mutable(static_cast<int>(index));
+    }
+
+    /**
+     * @brief set the value of the parameter at the position
+     * @return error code defined in error_code.h
+     */
+    template<typename T>
+    ErrorCode set(std::size_t index, const T& value) {
+        auto* p = parameter(index);
+        if (p == nullptr) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+        stub::parameter{p}(value);
+        return ErrorCode::OK;
+    }
+
+    void clear() noexcept {
+        for (auto& e : *parameters_) {
+            e.clear_value();
+        }
+    }
+
+    /**
+     * @brief get the request to execute the prepared statement in the transaction,
+     *  to be set in the request message by unsafe_arena_set_allocated_execute_prepared_statement()
+     */
+    ::jogasaki::proto::sql::request::ExecutePreparedStatement* statement(const ::jogasaki::proto::sql::common::Transaction& transaction_handle) {
+        *(statement_.mutable_transaction_handle()) = transaction_handle;
+        return &statement_;
+    }
+
+    /**
+     * @brief get the request to execute the prepared query in the transaction,
+     *  to be set in the request message by unsafe_arena_set_allocated_execute_prepared_query()
+     */
+    ::jogasaki::proto::sql::request::ExecutePreparedQuery* query(const ::jogasaki::proto::sql::common::Transaction& transaction_handle) {
+        *(query_.mutable_transaction_handle()) = transaction_handle;
+        return &query_;
+    }
+
+private:
+    bool has_result_records_;
+
+    // only the one for has_result_records_ is used
+    ::jogasaki::proto::sql::request::ExecutePreparedStatement statement_{};
+    ::jogasaki::proto::sql::request::ExecutePreparedQuery query_{};
+
+    google::protobuf::RepeatedPtrField<::jogasaki::proto::sql::request::Parameter>* parameters_;
+};
+
+}  // namespace ogawayama::stub
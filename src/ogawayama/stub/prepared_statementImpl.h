@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <utility>
+
 #include "ogawayama/stub/api.h"
 
 namespace ogawayama::stub {
@@ -25,13 +27,18 @@ namespace ogawayama::stub {
 class PreparedStatement::Impl
 {
 public:
-    Impl(Connection::Impl* manager, std::size_t id, bool has_result_records)
-        : manager_(manager), id_(id), has_result_records_(has_result_records) {}
+    Impl(Connection::Impl* manager, std::size_t id, bool has_result_records, placeholders_type placeholders = {})
+        : manager_(manager), id_(id), has_result_records_(has_result_records), placeholders_(std::move(placeholders)) {}
 
     [[nodiscard]] auto get_id() const { return id_; }
 
     [[nodiscard]] bool has_result_records() const { return has_result_records_; }
 
+    /**
+     * @brief get the placeholders given on prepare, in the order of the positions of ParameterBinder
+     */
+    [[nodiscard]] const placeholders_type& placeholders() const { return placeholders_; }
+
     /**
      * @brief get the object to which this belongs
      * @return stub objext
@@ -44,6 +51,8 @@ private:
     std::size_t id_;
 
     bool has_result_records_;
+
+    placeholders_type placeholders_;
 };
 
 }  // namespace ogawayama::stub
@@ -27,7 +27,8 @@ ResultSet::Impl::Impl(Transaction::Impl* manager, std::unique_ptr<tateyama::comm
       resultset_wire_(std::move(resultset_wire)),
       metadata_(std::move(metadata)),
       column_number_(metadata_.columns_size()),
-      query_index_(query_index)
+      query_index_(query_index),
+      decoder_(metadata_)
 {
 }
 
@@ -45,6 +46,7 @@ ResultSet::Impl::~Impl() {
 ErrorCode ResultSet::Impl::close() {
     try {
         resultset_wire_->set_closed();
+        (void) get_release_statistics(release_statistics_);
         resultset_wire_.reset();
         manager_->receive_body(query_index_);
         return ErrorCode::END_OF_ROW;
@@ -104,9 +106,11 @@ ErrorCode ResultSet::Impl::get_metadata(MetadataPtr& metadata)
  */
 ErrorCode ResultSet::Impl::next()
 {
-    if (c_idx_ != 0) {
-        resultset_wire_->dispose();
-        c_idx_ = 0;
+    if (!resultset_wire_) {
+        return ErrorCode::END_OF_ROW;
+    }
+    if (in_row_) {
+        dispose();
     }
     auto record = resultset_wire_->get_chunk();
     if (record.empty()) {
@@ -115,33 +119,171 @@ ErrorCode ResultSet::Impl::next()
     buf_ = jogasaki::serializer::buffer_view(const_cast<char*>(record.data()), record.size());
     iter_ = buf_.begin();
     jogasaki::serializer::read_row_begin(iter_, buf_.end());
+    in_row_ = true;
     return ErrorCode::OK;
 }
 
 /**
- * @brief get int64 value from the current row.
- * @param value returns the value
+ * @brief decode the following rows into the batch column by column
+ * @param max_rows the maximum number of rows to decode
+ * @param batch returns the rows decoded
  * @return error code defined in error_code.h
  */
-template<>
-ErrorCode ResultSet::Impl::next_column(std::int64_t& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
+ErrorCode ResultSet::Impl::next_batch(std::size_t max_rows, row_batch& batch)
+{
+    if (max_rows == 0) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    if (!decoder_.supported()) {
+        return ErrorCode::UNSUPPORTED;
+    }
+    MetadataPtr metadata{};
+    (void) get_metadata(metadata);
+    batch.reset(metadata->get_types());
+
+    for (std::size_t row = 0; row < max_rows; row++) {
+        if (auto rv = next(); rv != ErrorCode::OK) {
+            // END_OF_ROW is returned by the next call if some rows have been decoded
+            return (rv == ErrorCode::END_OF_ROW && row > 0) ? ErrorCode::OK : rv;
+        }
+        try {
+            decoder_.decode(iter_, buf_.end(), batch);
+        } catch (std::runtime_error &ex) {
+            std::cerr << "error: " << ex.what() << std::endl;
+            batch.truncate(row);  // drop the columns of the row decoded partway
+            return ErrorCode::COLUMN_TYPE_MISMATCH;
+        }
+        dispose();
+    }
+    return ErrorCode::OK;
+}
+
+/**
+ * @brief move to the next row and decode all of its columns
+ * @param row returns the values of the columns
+ * @return error code defined in error_code.h
+ */
+ErrorCode ResultSet::Impl::read_row(std::vector<value_type>& row)
+{
+    if (!decoder_.supported()) {
+        return ErrorCode::UNSUPPORTED;
+    }
+    if (auto rv = next(); rv != ErrorCode::OK) {
         return rv;
     }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
+    try {
+        decoder_.decode(iter_, buf_.end(), row);
+    } catch (std::runtime_error &ex) {
+        std::cerr << "error: " << ex.what() << std::endl;
+        return ErrorCode::COLUMN_TYPE_MISMATCH;
+    }
+    dispose();
+    return ErrorCode::OK;
+}
+
+/**
+ * @brief skip columns of the current row without decoding them
+ * @param columns the number of columns to skip
+ * @return error code defined in error_code.h
+ */
+ErrorCode ResultSet::Impl::skip_columns(std::size_t columns)
+{
+    for (std::size_t i = 0; i < columns; i++) {
+        if (auto rv = next_column_common(); rv != ErrorCode::OK) {
+            return rv;
+        }
+        try {
+            jogasaki::serializer::skip(iter_, buf_.end());
+        } catch (std::runtime_error &ex) {
+            std::cerr << "error: " << ex.what() << std::endl;
+            return ErrorCode::SERVER_ERROR;
+        }
+    }
+    return ErrorCode::OK;
+}
+
+/**
+ * @brief skip the rows following the current one without looking into them
+ * @param rows the number of rows to skip
+ * @return error code defined in error_code.h
+ */
+ErrorCode ResultSet::Impl::skip_rows(std::size_t rows)
+{
+    if (!resultset_wire_) {
         return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::int_:
-        value = jogasaki::serializer::read_int(iter_, buf_.end());
+    }
+    if (in_row_) {
+        dispose();
+    }
+    for (std::size_t i = 0; i < rows; i++) {
+        if (resultset_wire_->get_chunk().empty()) {
+            return close();
+        }
+        resultset_wire_->dispose();
+    }
+    return ErrorCode::OK;
+}
+
+/**
+ * @brief set the columns read by next_column()
+ * @param columns the flags of the columns to read, an empty one reads all of them
+ * @return error code defined in error_code.h
+ */
+ErrorCode ResultSet::Impl::set_projection(std::vector<bool> columns)
+{
+    if (!columns.empty() && columns.size() != column_number_) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    projection_ = std::move(columns);
+    return ErrorCode::OK;
+}
+
+/**
+ * @brief set how often the space of the rows read is returned to the server.
+ * @param records the number of rows read before their space is returned
+ * @param bytes the size of rows read before their space is returned, 0 means no limit by size
+ * @return error code defined in error_code.h
+ */
+ErrorCode ResultSet::Impl::set_release_batch(std::size_t records, std::size_t bytes)
+{
+    if (records == 0) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    if (resultset_wire_) {
+        resultset_wire_->set_release_batch(records, bytes);
+    }
+    return ErrorCode::OK;
+}
+
+/**
+ * @brief get the counters of the space returned to the server.
+ * @param statistics returns the counters
+ * @return error code defined in error_code.h
+ */
+ErrorCode ResultSet::Impl::get_release_statistics(release_statistics& statistics)
+{
+    if (!resultset_wire_) {
+        statistics = release_statistics_;
         return ErrorCode::OK;
-    default:
-        std::cerr << "error: int_ expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
     }
+    const auto& counters = resultset_wire_->get_release_statistics();
+    statistics.releases = counters.releases;
+    statistics.records = counters.records;
+    statistics.bytes = counters.bytes;
+    statistics.writer_stalls = counters.writer_stalls;
+    return ErrorCode::OK;
+}
+
+/**
+ * @brief get int64 value from the current row.
+ * @param value returns the value
+ * @return error code defined in error_code.h
+ */
+template<>
+ErrorCode ResultSet::Impl::next_column(std::int64_t& value) {
+    return read_column(
+        [](Type type) { return type == Type::INT32 || type == Type::INT64; },
+        [this, &value](Type) { value = jogasaki::serializer::read_int(iter_, buf_.end()); });
 }
 
 /**
@@ -151,26 +293,11 @@ ErrorCode ResultSet::Impl::next_column(std::int64_t& value) {
  */
 template<>
 ErrorCode ResultSet::Impl::next_column(double& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
-        return rv;
-    }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
-        return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::float8:
-        value = jogasaki::serializer::read_float8(iter_, buf_.end());
-        return ErrorCode::OK;
-    case jogasaki::serializer::entry_type::float4:
-        value = jogasaki::serializer::read_float4(iter_, buf_.end());
-        return ErrorCode::OK;
-    default:
-        std::cerr << "error: float4 or float8 expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
-    }
+    return read_column(
+        [](Type type) { return type == Type::FLOAT32 || type == Type::FLOAT64; },
+        [this, &value](Type type) {
+            value = (type == Type::FLOAT32) ? jogasaki::serializer::read_float4(iter_, buf_.end()) : jogasaki::serializer::read_float8(iter_, buf_.end());
+        });
 }
 
 template<>
@@ -202,26 +329,11 @@ ErrorCode ResultSet::Impl::next_column(float& value) {
  */
 template<>
 ErrorCode ResultSet::Impl::next_column(std::string_view& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
-        return rv;
-    }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
-        return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::character:
-        value = jogasaki::serializer::read_character(iter_, buf_.end());
-        return ErrorCode::OK;
-    case jogasaki::serializer::entry_type::octet:
-        value = jogasaki::serializer::read_octet(iter_, buf_.end());
-        return ErrorCode::OK;
-    default:
-        std::cerr << "error: character expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
-    }
+    return read_column(
+        [](Type type) { return type == Type::TEXT || type == Type::OCTET; },
+        [this, &value](Type type) {
+            value = (type == Type::TEXT) ? jogasaki::serializer::read_character(iter_, buf_.end()) : jogasaki::serializer::read_octet(iter_, buf_.end());
+        });
 }
 template<>
 ErrorCode ResultSet::Impl::next_column(std::string& value) {
@@ -244,23 +356,9 @@ ErrorCode ResultSet::Impl::next_column(std::string& value) {
  */
 template<>
 ErrorCode ResultSet::Impl::next_column(takatori::datetime::date& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
-        return rv;
-    }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
-        return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::date:
-        value = jogasaki::serializer::read_date(iter_, buf_.end());
-        return ErrorCode::OK;
-    default:
-        std::cerr << "error: date expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
-    }
+    return read_column(
+        [](Type type) { return type == Type::DATE; },
+        [this, &value](Type) { value = jogasaki::serializer::read_date(iter_, buf_.end()); });
 }
 
 /**
@@ -270,23 +368,9 @@ ErrorCode ResultSet::Impl::next_column(takatori::datetime::date& value) {
  */
 template<>
 ErrorCode ResultSet::Impl::next_column(takatori::datetime::time_of_day& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
-        return rv;
-    }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
-        return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::time_of_day:
-        value = jogasaki::serializer::read_time_of_day(iter_, buf_.end());
-        return ErrorCode::OK;
-    default:
-        std::cerr << "error: time_of_day expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
-    }
+    return read_column(
+        [](Type type) { return type == Type::TIME; },
+        [this, &value](Type) { value = jogasaki::serializer::read_time_of_day(iter_, buf_.end()); });
 }
 
 /**
@@ -296,23 +380,9 @@ ErrorCode ResultSet::Impl::next_column(takatori::datetime::time_of_day& value) {
  */
 template<>
 ErrorCode ResultSet::Impl::next_column(takatori::datetime::time_point& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
-        return rv;
-    }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
-        return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::time_point:
-        value = jogasaki::serializer::read_time_point(iter_, buf_.end());
-        return ErrorCode::OK;
-    default:
-        std::cerr << "error: time_point expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
-    }
+    return read_column(
+        [](Type type) { return type == Type::TIMESTAMP; },
+        [this, &value](Type) { value = jogasaki::serializer::read_time_point(iter_, buf_.end()); });
 }
 
 /**
@@ -322,23 +392,9 @@ ErrorCode ResultSet::Impl::next_column(takatori::datetime::time_point& value) {
  */
 template<>
 ErrorCode ResultSet::Impl::next_column(std::pair<takatori::datetime::time_of_day, std::int32_t>& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
-        return rv;
-    }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
-        return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::time_of_day_with_offset:
-        value = jogasaki::serializer::read_time_of_day_with_offset(iter_, buf_.end());
-        return ErrorCode::OK;
-    default:
-        std::cerr << "error: time_of_day_with_offset expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
-    }
+    return read_column(
+        [](Type type) { return type == Type::TIMETZ; },
+        [this, &value](Type) { value = jogasaki::serializer::read_time_of_day_with_offset(iter_, buf_.end()); });
 }
 
 /**
@@ -348,50 +404,21 @@ ErrorCode ResultSet::Impl::next_column(std::pair<takatori::datetime::time_of_day
  */
 template<>
 ErrorCode ResultSet::Impl::next_column(std::pair<takatori::datetime::time_point, std::int32_t>& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
-        return rv;
-    }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
-        return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::time_point_with_offset:
-        value = jogasaki::serializer::read_time_point_with_offset(iter_, buf_.end());
-        return ErrorCode::OK;
-    default:
-        std::cerr << "error: time_point_with_offset expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
-    }
+    return read_column(
+        [](Type type) { return type == Type::TIMESTAMPTZ; },
+        [this, &value](Type) { value = jogasaki::serializer::read_time_point_with_offset(iter_, buf_.end()); });
 }
 
 /**
- * @brief get time_point_with_offset value from the current row.
+ * @brief get decimal value from the current row.
  * @param value returns the value
  * @return error code defined in error_code.h
  */
 template<>
 ErrorCode ResultSet::Impl::next_column(takatori::decimal::triple& value) {
-    if (auto rv = next_column_common(); rv != ErrorCode::OK) {
-        return rv;
-    }
-    switch (auto entry_type = jogasaki::serializer::peek_type(iter_, buf_.end())) {
-    case jogasaki::serializer::entry_type::end_of_contents:
-        jogasaki::serializer::read_end_of_contents(iter_, buf_.end());
-        return ErrorCode::END_OF_ROW;
-    case jogasaki::serializer::entry_type::null:
-        jogasaki::serializer::read_null(iter_, buf_.end());
-        return ErrorCode::COLUMN_WAS_NULL;
-    case jogasaki::serializer::entry_type::decimal:
-    case jogasaki::serializer::entry_type::int_:
-        value = jogasaki::serializer::read_decimal(iter_, buf_.end());
-        return ErrorCode::OK;
-    default:
-        std::cerr << "error: decimal expected, actually " << jogasaki::serializer::to_string_view(entry_type) << " received" << std::endl;
-        return ErrorCode::COLUMN_TYPE_MISMATCH;
-    }
+    return read_column(
+        [](Type type) { return type == Type::DECIMAL || type == Type::INT32 || type == Type::INT64; },
+        [this, &value](Type) { value = jogasaki::serializer::read_decimal(iter_, buf_.end()); });
 }
 
 
@@ -443,4 +470,18 @@ ErrorCode ResultSet::next_column(std::pair<takatori::datetime::time_point, std::
 template<>
 ErrorCode ResultSet::next_column(takatori::decimal::triple& value) { return impl_->next_column(value); }
 
+ErrorCode ResultSet::next_batch(std::size_t max_rows, row_batch& batch) { return impl_->next_batch(max_rows, batch); }
+
+ErrorCode ResultSet::read_row(std::vector<value_type>& row) { return impl_->read_row(row); }
+
+ErrorCode ResultSet::skip_columns(std::size_t columns) { return impl_->skip_columns(columns); }
+
+ErrorCode ResultSet::skip_rows(std::size_t rows) { return impl_->skip_rows(rows); }
+
+ErrorCode ResultSet::set_projection(std::vector<bool> columns) { return impl_->set_projection(std::move(columns)); }
+
+ErrorCode ResultSet::set_release_batch(std::size_t records, std::size_t bytes) { return impl_->set_release_batch(records, bytes); }
+
+ErrorCode ResultSet::get_release_statistics(release_statistics& statistics) { return impl_->get_release_statistics(statistics); }
+
 }  // namespace ogawayama::stub
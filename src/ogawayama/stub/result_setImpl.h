@@ -19,6 +19,7 @@
 
 #include "ogawayama/stub/api.h"
 #include "connectionImpl.h"
+#include "row_decoder.h"
 
 namespace ogawayama::stub {
 
@@ -40,6 +41,13 @@ public:
     ErrorCode next();
     template<typename T>
         ErrorCode next_column(T &value);
+    ErrorCode next_batch(std::size_t max_rows, row_batch& batch);
+    ErrorCode read_row(std::vector<value_type>& row);
+    ErrorCode skip_columns(std::size_t columns);
+    ErrorCode skip_rows(std::size_t rows);
+    ErrorCode set_projection(std::vector<bool> columns);
+    ErrorCode set_release_batch(std::size_t records, std::size_t bytes);
+    ErrorCode get_release_statistics(release_statistics& statistics);
 
  private:
     Transaction::Impl* manager_;
@@ -47,6 +55,7 @@ public:
     ::jogasaki::proto::sql::response::ResultSetMetadata metadata_;
     std::size_t column_number_;
     std::size_t query_index_;
+    row_decoder decoder_;
 
     ogawayama::stub::Metadata ogawayama_metadata_{};
     bool ogawayama_metadata_valid_{false};
@@ -55,17 +64,59 @@ public:
     jogasaki::serializer::buffer_view::const_iterator iter_{};
 
     std::size_t c_idx_{0};
+    bool in_row_{false};  // the current row has yet to be disposed of
+    std::vector<bool> projection_{};  // the columns read by next_column(), all of them if empty
+    release_statistics release_statistics_{};  // kept after the wire is closed
 
     ErrorCode next_column_common() {
         if (resultset_wire_->is_eor() && resultset_wire_->active_wire() == nullptr) {
             return close();
         }
+        if (!projection_.empty()) {
+            while (c_idx_ < column_number_ && !projection_[c_idx_]) {
+                jogasaki::serializer::skip(iter_, buf_.end());
+                c_idx_++;
+            }
+        }
         if (c_idx_++ < column_number_) {
             return ErrorCode::OK;
         }
+        dispose();
+        return ErrorCode::END_OF_COLUMN;
+    }
+    void dispose() {
         resultset_wire_->dispose();
         c_idx_ = 0;
-        return ErrorCode::END_OF_COLUMN;
+        in_row_ = false;
+    }
+
+    using Type = Metadata::ColumnType::Type;
+
+    /**
+     * @brief read the current column, whose type is taken from the decoder plan instead of the entry.
+     * @param accepts the predicate telling whether the column of the type can be read
+     * @param reader the function reading the entry of the column of the type given
+     * @return error code defined in error_code.h
+     */
+    template<typename Accepts, typename Reader>
+    ErrorCode read_column(Accepts&& accepts, Reader&& reader) {
+        if (auto rv = next_column_common(); rv != ErrorCode::OK) {
+            return rv;
+        }
+        try {
+            if (row_decoder::read_if_null(iter_, buf_.end())) {
+                return ErrorCode::COLUMN_WAS_NULL;
+            }
+            auto type = decoder_.column_type(c_idx_ - 1);
+            if (!accepts(type)) {
+                jogasaki::serializer::skip(iter_, buf_.end());  // keep the position at the next column
+                return ErrorCode::COLUMN_TYPE_MISMATCH;
+            }
+            reader(type);
+            return ErrorCode::OK;
+        } catch (std::runtime_error &ex) {  // the entry is not of the column type
+            return ErrorCode::COLUMN_TYPE_MISMATCH;
+        }
     }
 
     ErrorCode close();
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <stdexcept>
+
+#include "row_decoder.h"
+
+namespace ogawayama::stub {
+
+namespace {
+
+using const_iterator = row_decoder::const_iterator;
+
+std::int32_t read_int4(const_iterator& position, const_iterator end) {
+    return static_cast<std::int32_t>(jogasaki::serializer::read_int(position, end));
+}
+
+void put(column_vector& column, std::string_view value) { column.push_text(value); }
+template<typename T>
+void put(column_vector& column, T value) { column.push(value); }
+
+void put(value_type& entry, std::string_view value, Metadata::ColumnType::Type type) {
+    if (type == Metadata::ColumnType::Type::OCTET) {
+        auto* bytes = std::get_if<binary_type>(&entry);
+        if (bytes == nullptr) {
+            bytes = &entry.emplace<binary_type>();
+        }
+        bytes->assign(value.begin(), value.end());
+        return;
+    }
+    auto* text = std::get_if<std::string>(&entry);
+    if (text == nullptr) {
+        text = &entry.emplace<std::string>();
+    }
+    text->assign(value);
+}
+template<typename T>
+void put(value_type& entry, T value, Metadata::ColumnType::Type) { entry = value; }
+
+template<typename T, T (*Read)(const_iterator&, const_iterator)>
+void to_column(const_iterator& position, const_iterator end, column_vector& column) {
+    if (row_decoder::read_if_null(position, end)) {
+        column.push_null();
+        return;
+    }
+    put(column, Read(position, end));
+}
+
+template<typename T, T (*Read)(const_iterator&, const_iterator), Metadata::ColumnType::Type Type>
+void to_value(const_iterator& position, const_iterator end, value_type& entry) {
+    if (row_decoder::read_if_null(position, end)) {
+        entry = std::monostate{};
+        return;
+    }
+    put(entry, Read(position, end), Type);
+}
+
+template<typename Sink>
+void unsupported(const_iterator&, const_iterator, Sink&) {
+    throw std::runtime_error("the column type is not supported");
+}
+
+}  // namespace
+
+row_decoder::row_decoder(const ::jogasaki::proto::sql::response::ResultSetMetadata& metadata) {
+    using Type = Metadata::ColumnType::Type;
+    namespace serializer = jogasaki::serializer;
+
+    auto size = static_cast<std::size_t>(metadata.columns_size());
+    to_column_.reserve(size);
+    to_value_.reserve(size);
+    kinds_.reserve(size);
+    types_.reserve(size);
+    for (auto&& column : metadata.columns()) {
+        if (column.type_info_case() != ::jogasaki::proto::sql::common::Column::TypeInfoCase::kAtomType) {
+            to_column_.emplace_back(unsupported<column_vector>);
+            to_value_.emplace_back(unsupported<value_type>);
+            kinds_.emplace_back(run_kind::none);
+            types_.emplace_back(Type::NULL_VALUE);
+            supported_ = false;
+            continue;
+        }
+        kinds_.emplace_back(run_kind::none);
+        types_.emplace_back(Type::NULL_VALUE);
+        switch(column.atom_type()) {
+        case ::jogasaki::proto::sql::common::AtomType::INT4:
+            to_column_.emplace_back(to_column<std::int32_t, read_int4>);
+            to_value_.emplace_back(to_value<std::int32_t, read_int4, Type::INT32>);
+            types_.back() = Type::INT32;
+            kinds_.back() = run_kind::int4;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::INT8:
+            to_column_.emplace_back(to_column<std::int64_t, serializer::read_int>);
+            to_value_.emplace_back(to_value<std::int64_t, serializer::read_int, Type::INT64>);
+            types_.back() = Type::INT64;
+            kinds_.back() = run_kind::int8;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::FLOAT4:
+            to_column_.emplace_back(to_column<float, serializer::read_float4>);
+            to_value_.emplace_back(to_value<float, serializer::read_float4, Type::FLOAT32>);
+            types_.back() = Type::FLOAT32;
+            kinds_.back() = run_kind::float4;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::FLOAT8:
+            to_column_.emplace_back(to_column<double, serializer::read_float8>);
+            to_value_.emplace_back(to_value<double, serializer::read_float8, Type::FLOAT64>);
+            types_.back() = Type::FLOAT64;
+            kinds_.back() = run_kind::float8;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::DECIMAL:
+            to_column_.emplace_back(to_column<decimal_type, serializer::read_decimal>);
+            to_value_.emplace_back(to_value<decimal_type, serializer::read_decimal, Type::DECIMAL>);
+            types_.back() = Type::DECIMAL;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::CHARACTER:
+            to_column_.emplace_back(to_column<std::string_view, serializer::read_character>);
+            to_value_.emplace_back(to_value<std::string_view, serializer::read_character, Type::TEXT>);
+            types_.back() = Type::TEXT;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::OCTET:
+            to_column_.emplace_back(to_column<std::string_view, serializer::read_octet>);
+            to_value_.emplace_back(to_value<std::string_view, serializer::read_octet, Type::OCTET>);
+            types_.back() = Type::OCTET;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::DATE:
+            to_column_.emplace_back(to_column<date_type, serializer::read_date>);
+            to_value_.emplace_back(to_value<date_type, serializer::read_date, Type::DATE>);
+            types_.back() = Type::DATE;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::TIME_OF_DAY:
+            to_column_.emplace_back(to_column<time_type, serializer::read_time_of_day>);
+            to_value_.emplace_back(to_value<time_type, serializer::read_time_of_day, Type::TIME>);
+            types_.back() = Type::TIME;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::TIME_POINT:
+            to_column_.emplace_back(to_column<timestamp_type, serializer::read_time_point>);
+            to_value_.emplace_back(to_value<timestamp_type, serializer::read_time_point, Type::TIMESTAMP>);
+            types_.back() = Type::TIMESTAMP;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::TIME_OF_DAY_WITH_TIME_ZONE:
+            to_column_.emplace_back(to_column<timetz_type, serializer::read_time_of_day_with_offset>);
+            to_value_.emplace_back(to_value<timetz_type, serializer::read_time_of_day_with_offset, Type::TIMETZ>);
+            types_.back() = Type::TIMETZ;
+            break;
+        case ::jogasaki::proto::sql::common::AtomType::TIME_POINT_WITH_TIME_ZONE:
+            to_column_.emplace_back(to_column<timestamptz_type, serializer::read_time_point_with_offset>);
+            to_value_.emplace_back(to_value<timestamptz_type, serializer::read_time_point_with_offset, Type::TIMESTAMPTZ>);
+            types_.back() = Type::TIMESTAMPTZ;
+            break;
+        default:
+            to_column_.emplace_back(unsupported<column_vector>);
+            to_value_.emplace_back(unsupported<value_type>);
+            supported_ = false;
+            break;
+        }
+    }
+
+    runs_.resize(size);
+    for (std::size_t i = size; i > 0; i--) {
+        auto& run = runs_[i - 1];
+        run = kinds_[i - 1] == run_kind::none ? 0 : 1;
+        if (run != 0 && i < size && kinds_[i] == kinds_[i - 1]) {
+            run += runs_[i];
+        }
+    }
+}
+
+void row_decoder::decode(const_iterator& position, const_iterator end, row_batch& batch) const {
+    std::size_t i = 0;
+    while (i < to_column_.size()) {
+        if (runs_[i] > 1) {
+            auto n = decode_run(position, end, batch, i);
+            i += n;
+            if (n > 0) {
+                continue;
+            }
+        }
+        // a column out of runs, or the entry that has broken a run
+        to_column_[i](position, end, batch.column(i));
+        i++;
+    }
+}
+
+std::size_t row_decoder::decode_run(const_iterator& position, const_iterator end, row_batch& batch, std::size_t first) const {
+    auto length = std::min(runs_[first], max_run);
+    switch (kinds_[first]) {
+    case run_kind::int4: {
+        std::array<std::int64_t, max_run> values{};
+        auto n = jogasaki::serializer::read_ints(position, end, values.data(), length);
+        for (std::size_t j = 0; j < n; j++) {
+            batch.column(first + j).push(static_cast<std::int32_t>(values[j]));  // NOLINT
+        }
+        return n;
+    }
+    case run_kind::int8: {
+        std::array<std::int64_t, max_run> values{};
+        auto n = jogasaki::serializer::read_ints(position, end, values.data(), length);
+        for (std::size_t j = 0; j < n; j++) {
+            batch.column(first + j).push(values[j]);  // NOLINT
+        }
+        return n;
+    }
+    case run_kind::float4: {
+        std::array<float, max_run> values{};
+        auto n = jogasaki::serializer::read_float4s(position, end, values.data(), length);
+        for (std::size_t j = 0; j < n; j++) {
+            batch.column(first + j).push(values[j]);  // NOLINT
+        }
+        return n;
+    }
+    case run_kind::float8: {
+        std::array<double, max_run> values{};
+        auto n = jogasaki::serializer::read_float8s(position, end, values.data(), length);
+        for (std::size_t j = 0; j < n; j++) {
+            batch.column(first + j).push(values[j]);  // NOLINT
+        }
+        return n;
+    }
+    default:
+        return 0;
+    }
+}
+
+void row_decoder::decode(const_iterator& position, const_iterator end, std::vector<value_type>& row) const {
+    row.resize(to_value_.size());
+    for (std::size_t i = 0; i < to_value_.size(); i++) {
+        to_value_[i](position, end, row[i]);
+    }
+}
+
+}  // namespace ogawayama::stub
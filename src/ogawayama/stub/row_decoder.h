@@ -0,0 +1,99 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <jogasaki/proto/sql/response.pb.h>
+#include <jogasaki/serializer/value_input.h>
+#include <jogasaki/serializer/details/value_io_constants.h>
+
+#include "ogawayama/stub/api.h"
+
+namespace ogawayama::stub {
+
+/**
+ * @brief the plan to decode the rows of a result set, compiled from its metadata once.
+ *  Each column is decoded by the function for its type, which looks at the entry only to see if it is NULL,
+ *  so an entry of another type is detected by the serializer throwing std::runtime_error.
+ *  Consecutive INT4, INT8, FLOAT4 or FLOAT8 columns of the same type are decoded into a batch as a run,
+ *  by a single call to the serializer until a NULL breaks it.
+ *  The column types are also kept for next_column() to check the type requested against them without looking into the entry.
+ */
+class row_decoder {
+public:
+    using const_iterator = jogasaki::serializer::buffer_view::const_iterator;
+    template<typename Sink>
+    using function_type = void (*)(const_iterator&, const_iterator, Sink&);
+
+    /**
+     * @brief Construct a new object.
+     * @param metadata the metadata of the result set
+     */
+    explicit row_decoder(const ::jogasaki::proto::sql::response::ResultSetMetadata& metadata);
+
+    /**
+     * @brief check whether every column is of a type that can be decoded.
+     */
+    [[nodiscard]] bool supported() const noexcept { return supported_; }
+
+    /**
+     * @brief get the type of the column decoded.
+     * @param column the column number, begins from zero
+     * @return the type, NULL_VALUE if the column cannot be decoded
+     */
+    [[nodiscard]] Metadata::ColumnType::Type column_type(std::size_t column) const noexcept { return types_[column]; }
+
+    /**
+     * @brief read the entry if it is NULL.
+     * @return true if the entry is NULL and has been read
+     */
+    static bool read_if_null(const_iterator& position, const_iterator end) noexcept {
+        if (position != end && static_cast<unsigned char>(*position) == jogasaki::serializer::details::header_unknown) {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief decode the columns of a row, whose row_begin has been read, into the batch.
+     * @throws std::runtime_error if the row does not match the metadata
+     */
+    void decode(const_iterator& position, const_iterator end, row_batch& batch) const;
+
+    /**
+     * @brief decode the columns of a row, whose row_begin has been read, into the values.
+     * @throws std::runtime_error if the row does not match the metadata
+     */
+    void decode(const_iterator& position, const_iterator end, std::vector<value_type>& row) const;
+
+private:
+    enum class run_kind { none, int4, int8, float4, float8 };
+    static constexpr std::size_t max_run = 64;
+
+    std::vector<function_type<column_vector>> to_column_{};
+    std::vector<function_type<value_type>> to_value_{};
+    std::vector<run_kind> kinds_{};
+    std::vector<Metadata::ColumnType::Type> types_{};
+    std::vector<std::size_t> runs_{};  // the number of columns of the same kind following each column, itself included
+    bool supported_{true};
+
+    std::size_t decode_run(const_iterator& position, const_iterator end, row_batch& batch, std::size_t first) const;
+};
+
+}  // namespace ogawayama::stub
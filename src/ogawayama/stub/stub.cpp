@@ -17,12 +17,30 @@
 #include <stdexcept>
 
 #include "connectionImpl.h"
+#include "connection_pool.h"
 #include "result_setImpl.h"
 
 #include "stubImpl.h"
 
 namespace ogawayama::stub {
 
+static bool is_valid_connection_option(const boost::property_tree::ptree& option) {
+    auto slot_count = tateyama::common::wire::slot_policy::default_count;
+    if (auto count = option.get_optional<std::size_t>(SLOT_COUNT); count) {
+        if (count.value() == 0 || count.value() > tateyama::common::wire::slot_policy::max_count) {
+            return false;
+        }
+        slot_count = count.value();
+    }
+    auto size = option.get_optional<std::size_t>(DISPOSAL_QUEUE_SIZE);
+    if (size || option.get<bool>(DEFERRED_DISPOSAL, false)) {
+        // a slot is left for the request that flushes the queue
+        auto queue_size = size ? size.value() : disposal_queue::default_capacity;
+        return queue_size > 0 && queue_size < slot_count;
+    }
+    return true;
+}
+
 Stub::Impl::Impl(Stub *stub, std::string_view database_name)
     : envelope_(stub), database_name_(database_name), connection_container_(database_name) {}
 
@@ -36,33 +54,106 @@ Stub::Impl::~Impl() = default;
  */
 ErrorCode Stub::Impl::get_connection(ConnectionPtr& connection, std::size_t n)
 {
-    std::string sid{};
-    try {
-        sid = connection_container_.connect();
-    } catch (std::runtime_error &e) {
-        return ErrorCode::SERVER_FAILURE;
-    }
+    return get_connection(connection, n, boost::property_tree::ptree{});
+}
 
-    try {
-        auto connection_impl = std::make_unique<Connection::Impl>(this, sid, n, credential_handler_);
+/**
+ * @brief connect to the DB and get Connection class with authentication information
+ * @param connection returns a connection class
+ * @param n supposed to be given MyProc->pgprocno for the first param // obsolete
+ * @param auth the authentication information
+ * @return true in error, otherwise false
+ */
+ErrorCode Stub::Impl::get_connection(ConnectionPtr& connection, std::size_t n, const Auth& auth)
+{
+    return get_connection(connection, n, auth, boost::property_tree::ptree{});
+}
+
+/**
+ * @brief connect to the DB and get Connection class with connection option
+ * @param connection returns a connection class
+ * @param n supposed to be given MyProc->pgprocno for the first param // obsolete
+ * @param option the connection option
+ * @return true in error, otherwise false
+ */
+ErrorCode Stub::Impl::get_connection(ConnectionPtr& connection, std::size_t n, const boost::property_tree::ptree& option)
+{
+    if (!is_valid_connection_option(option)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    std::unique_ptr<Connection::Impl> connection_impl{};
+    ErrorCode rc{};
+    if (connection_pool_ && connection_pool_->matches(nullptr, option)) {
+        rc = connection_pool_->acquire(connection_impl, n);
+    } else {
+        rc = connect(connection_impl, n, credential_handler_, option);
+    }
+    if (rc == ErrorCode::OK) {
         connection = std::make_unique<Connection>(std::move(connection_impl));
-        return connection->get_impl()->hello();
-    } catch (std::runtime_error &e) {
-        if (std::stoi(e.what()) == tateyama::proto::diagnostics::Code::AUTHENTICATION_ERROR){
-            return ErrorCode::AUTHENTICATION_ERROR;
-        }
-        return ErrorCode::SERVER_FAILURE;
     }
+    return rc;
 }
 
 /**
- * @brief connect to the DB and get Connection class with authentication information
+ * @brief connect to the DB and get Connection class with authentication information and connection option
  * @param connection returns a connection class
  * @param n supposed to be given MyProc->pgprocno for the first param // obsolete
  * @param auth the authentication information
+ * @param option the connection option
  * @return true in error, otherwise false
  */
-ErrorCode Stub::Impl::get_connection(ConnectionPtr& connection, std::size_t n, const Auth& auth)
+ErrorCode Stub::Impl::get_connection(ConnectionPtr& connection, std::size_t n, const Auth& auth, const boost::property_tree::ptree& option)
+{
+    if (!is_valid_connection_option(option)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    std::unique_ptr<Connection::Impl> connection_impl{};
+    ErrorCode rc{};
+    if (connection_pool_ && connection_pool_->matches(&auth, option)) {
+        rc = connection_pool_->acquire(connection_impl, n);
+    } else {
+        credential_handler_.set_user_password(auth.user(), auth.password());
+        rc = connect(connection_impl, n, credential_handler_, option);
+    }
+    if (rc == ErrorCode::OK) {
+        connection = std::make_unique<Connection>(std::move(connection_impl));
+    }
+    return rc;
+}
+
+/**
+ * @brief open the pool of the sessions handshaked in advance
+ * @param pool_option the pool option
+ * @param auth the authentication information of the sessions, if any
+ * @param option the connection option of the sessions
+ * @return error code defined in error_code.h
+ */
+ErrorCode Stub::Impl::open_connection_pool(const boost::property_tree::ptree& pool_option, std::optional<Auth> auth, const boost::property_tree::ptree& option)
+{
+    if (!connection_pool::is_valid_option(pool_option) || !is_valid_connection_option(option)) {
+        return ErrorCode::INVALID_PARAMETER;
+    }
+    close_connection_pool();
+    auto pool = std::make_shared<connection_pool>(this, pool_option, std::move(auth), option);
+    if (auto rc = pool->fill(); rc != ErrorCode::OK) {
+        return rc;
+    }
+    connection_pool_ = std::move(pool);
+    return ErrorCode::OK;
+}
+
+/**
+ * @brief close the sessions in the pool
+ */
+void Stub::Impl::close_connection_pool()
+{
+    connection_pool_ = nullptr;
+}
+
+/**
+ * @brief connect a session to the DB and handshake it
+ */
+ErrorCode Stub::Impl::connect(std::unique_ptr<Connection::Impl>& connection_impl, std::size_t n, tateyama::authentication::credential_handler& credential_handler, const boost::property_tree::ptree& option)
 {
     std::string sid{};
     try {
@@ -72,10 +163,8 @@ ErrorCode Stub::Impl::get_connection(ConnectionPtr& connection, std::size_t n, c
     }
 
     try {
-        credential_handler_.set_user_password(auth.user(), auth.password());
-        auto connection_impl = std::make_unique<Connection::Impl>(this, sid, n, credential_handler_);
-        connection = std::make_unique<Connection>(std::move(connection_impl));
-        return connection->get_impl()->hello();
+        connection_impl = std::make_unique<Connection::Impl>(this, sid, n, credential_handler, option);
+        return connection_impl->hello();
     } catch (std::runtime_error &e) {
         if (std::stoi(e.what()) == tateyama::proto::diagnostics::Code::AUTHENTICATION_ERROR){
             return ErrorCode::AUTHENTICATION_ERROR;
@@ -121,6 +210,46 @@ ErrorCode Stub::get_connection(ConnectionPtr & connection, std::size_t n, const
     return impl_->get_connection(connection, n, auth);
 }
 
+/**
+ * @brief connect to the DB and get Connection class with connection option.
+ */
+ErrorCode Stub::get_connection(ConnectionPtr & connection, std::size_t n, const boost::property_tree::ptree& option)
+{
+    return impl_->get_connection(connection, n, option);
+}
+
+/**
+ * @brief connect to the DB and get Connection class with authentication information and connection option.
+ */
+ErrorCode Stub::get_connection(ConnectionPtr & connection, std::size_t n, const Auth& auth, const boost::property_tree::ptree& option)
+{
+    return impl_->get_connection(connection, n, auth, option);
+}
+
+/**
+ * @brief open the pool of the sessions handshaked in advance.
+ */
+ErrorCode Stub::open_connection_pool(const boost::property_tree::ptree& pool_option, const boost::property_tree::ptree& option)
+{
+    return impl_->open_connection_pool(pool_option, std::nullopt, option);
+}
+
+/**
+ * @brief open the pool of the sessions handshaked in advance with authentication information.
+ */
+ErrorCode Stub::open_connection_pool(const boost::property_tree::ptree& pool_option, const Auth& auth, const boost::property_tree::ptree& option)
+{
+    return impl_->open_connection_pool(pool_option, auth, option);
+}
+
+/**
+ * @brief close the sessions in the pool.
+ */
+void Stub::close_connection_pool()
+{
+    impl_->close_connection_pool();
+}
+
 }  // namespace ogawayama::stub
 
 
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include <ogawayama/stub/api.h>
 
@@ -40,12 +41,28 @@ public:
 
     ErrorCode get_connection(ConnectionPtr&, std::size_t);
     ErrorCode get_connection(ConnectionPtr&, std::size_t, const Auth&);
+    ErrorCode get_connection(ConnectionPtr&, std::size_t, const boost::property_tree::ptree&);
+    ErrorCode get_connection(ConnectionPtr&, std::size_t, const Auth&, const boost::property_tree::ptree&);
     std::string_view get_database_name() { return database_name_; }
 
+    ErrorCode open_connection_pool(const boost::property_tree::ptree&, std::optional<Auth>, const boost::property_tree::ptree&);
+    void close_connection_pool();
+
+    /**
+     * @brief connect a session to the DB and handshake it
+     * @param connection_impl returns the session
+     * @param n supposed to be given MyProc->pgprocno // obsolete
+     * @param credential_handler the credential of the session
+     * @param option the connection option, which must be valid
+     * @return error code defined in error_code.h
+     */
+    ErrorCode connect(std::unique_ptr<Connection::Impl>& connection_impl, std::size_t n, tateyama::authentication::credential_handler& credential_handler, const boost::property_tree::ptree& option);
+
 private:
     const Stub *envelope_;
     const std::string database_name_;
     tateyama::common::wire::connection_container connection_container_;
+    std::shared_ptr<connection_pool> connection_pool_{};
 
     friend class Stub;
     tateyama::authentication::credential_handler credential_handler_{};
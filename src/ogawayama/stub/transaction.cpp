@@ -16,11 +16,13 @@
 
 #include <iostream>
 #include <exception>
-#include <array>
 #include <cstdint>
 
-#include <boost/multiprecision/cpp_int.hpp>
+#include <google/protobuf/io/coded_stream.h>
 
+#include "deferred_completion.h"
+#include "parameter.h"
+#include "parameter_binderImpl.h"
 #include "prepared_statementImpl.h"
 #include "result_setImpl.h"
 #include "transactionImpl.h"
@@ -35,7 +37,11 @@ Transaction::Impl::~Impl()
 {
     try {
         if (alive_) {
-            rollback();
+            if (auto* queue = manager_->get_disposal_queue(); queue != nullptr) {
+                queue->rollback(transaction_handle_);
+            } else {
+                rollback();
+            }
             alive_ = false;
         }
     } catch (std::exception &ex) {
@@ -45,7 +51,7 @@ Transaction::Impl::~Impl()
 
 static inline std::size_t num_rows_processed(const ::jogasaki::proto::sql::response::ExecuteResult::Success& message) {
     std::size_t num_rows{};
-    auto counters = message.counters();
+    const auto& counters = message.counters();
     for (auto&& e: counters) {
         auto type = e.type();
         if (type == ::jogasaki::proto::sql::response::ExecuteResult::INSERTED_ROWS ||
@@ -89,102 +95,81 @@ ErrorCode Transaction::Impl::execute_statement(std::string_view statement, std::
     return ErrorCode::NO_TRANSACTION;
 }
 
-class parameter {
-public:
-    explicit parameter(const std::string& name) {
-        parameter_.set_name(name);
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const std::monostate& data) {
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const std::int32_t& data) {
-        parameter_.set_int4_value(data);
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const std::int64_t& data) {
-        parameter_.set_int8_value(data);
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const float& data) {
-        parameter_.set_float4_value(data);
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const double& data) {
-        parameter_.set_float8_value(data);
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const std::string& data) {
-        parameter_.set_character_value(data);
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const binary_type& data) {
-        parameter_.set_octet_value(std::string(reinterpret_cast<const char*>(data.data()), data.size()));  //  NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const date_type& data) {
-        parameter_.set_date_value(data.days_since_epoch());
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const time_type& data) {
-        parameter_.set_time_of_day_value(data.time_since_epoch().count());
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const timestamp_type& data) {
-        auto v = parameter_.mutable_time_point_value();
-        v->set_offset_seconds(data.seconds_since_epoch().count());
-        v->set_nano_adjustment(data.subsecond().count());
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const timetz_type& data) {
-        auto v = parameter_.mutable_time_of_day_with_time_zone_value();
-        v->set_time_zone_offset(data.second);
-        v->set_offset_nanoseconds(data.first.time_since_epoch().count());
-        return parameter_;
-    }
-    ::jogasaki::proto::sql::request::Parameter operator()(const timestamptz_type& data) {
-        auto v = parameter_.mutable_time_point_with_time_zone_value();
-        v->set_time_zone_offset(data.second);
-        v->set_offset_seconds(data.first.seconds_since_epoch().count());
-        v->set_nano_adjustment(data.first.subsecond().count());
-        return parameter_;
-    }
-
-    ::jogasaki::proto::sql::request::Parameter operator()(const decimal_type& triple) {
-        auto* value = &parameter_;
-        boost::multiprecision::cpp_int v = triple.coefficient_high();
-        v <<= sizeof(std::uint64_t) * 8;
-        v |= triple.coefficient_low();
-        if (triple.sign() < 0) {
-            v *= -1;
-        }
-        constexpr std::size_t max_decimal_length = sizeof(std::uint64_t) * 2 + 1;
-        std::array<std::uint8_t, max_decimal_length> out{};
-        boost::multiprecision::cpp_int mask = UINT8_MAX;
-        for (std::size_t i = 0; i < max_decimal_length; i++) {
-            out.at((max_decimal_length - 1) - i) = static_cast<std::uint8_t>((v >> (i * 8)) & mask);
-        }
-        std::size_t skip = 0;
-        for (std::size_t i = 0; i < (max_decimal_length - 1); i++) {
-            if ((triple.sign() > 0 && (out.at(i) == 0)) || (triple.sign() < 0 && (out.at(i) == UINT8_MAX))) {
-                skip++;
-                continue;
-            }
-            break;
-        }
-        constexpr std::uint8_t sign = static_cast<std::uint8_t>(1) << ((sizeof(std::uint8_t) * 8) - 1);
-        if (((triple.sign() > 0) && ((out.at(skip) & sign) != 0))
-            || ((triple.sign() < 0) && ((out.at(skip) & sign) != sign))) {
-            skip--;
+void Transaction::Impl::build_execute_prepared_statement(::jogasaki::proto::sql::request::Request& req, PreparedStatement::Impl* ps_impl, const parameters_type& parameters) {
+    auto* request = req.mutable_execute_prepared_statement();
+    *(request->mutable_transaction_handle()) = transaction_handle_;
+    auto* prepaed_statement = request->mutable_prepared_statement_handle();
+    prepaed_statement->set_handle(ps_impl->get_id());
+    prepaed_statement->set_has_result_records(ps_impl->has_result_records());
+    for (auto& e : parameters) {
+        std::visit(parameter(request->add_parameters(), e.first), e.second);
+    }
+}
+
+void Transaction::Impl::build_execute_prepared_query(::jogasaki::proto::sql::request::Request& req, PreparedStatement::Impl* ps_impl, const parameters_type& parameters) {
+    auto* request = req.mutable_execute_prepared_query();
+    *(request->mutable_transaction_handle()) = transaction_handle_;
+    auto* prepaed_statement = request->mutable_prepared_statement_handle();
+    prepaed_statement->set_handle(ps_impl->get_id());
+    prepaed_statement->set_has_result_records(ps_impl->has_result_records());
+    for (auto& e : parameters) {
+        std::visit(parameter(request->add_parameters(), e.first), e.second);
+    }
+}
+
+/**
+ * @brief receive the response of an execute statement request, reading it in place.
+ */
+ErrorCode Transaction::Impl::complete_execute_statement(tateyama::common::wire::message_header::index_type slot_index, std::size_t& num_rows) {
+    try {
+        auto rv = transport_.complete(
+            [this, &num_rows](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<ErrorCode> {
+                if (!response_message.has_execute_result()) {
+                    return std::nullopt;
+                }
+                const auto& response = response_message.execute_result();
+                transport_.set_sql_error(response);
+                if (response.has_success()) {
+                    num_rows = num_rows_processed(response.success());
+                    return ErrorCode::OK;
+                }
+                return ErrorCode::SERVER_ERROR;
+            }, slot_index);
+        if (!rv) {
+            return ErrorCode::SERVER_FAILURE;
         }
-        auto *decimal = value->mutable_decimal_value();
-        decimal->set_unscaled_value(out.data() + skip, max_decimal_length - skip);
-        decimal->set_exponent(triple.exponent());
-        return parameter_;
+        return rv.value();
+    } catch (std::runtime_error &e) {
+        return ErrorCode::SERVER_ERROR;
     }
+}
 
-private:
-    ::jogasaki::proto::sql::request::Parameter parameter_{};
-};
+/**
+ * @brief receive the response of an execute query request and make the result set.
+ */
+ErrorCode Transaction::Impl::complete_execute_query(tateyama::common::wire::message_header::index_type query_index, std::shared_ptr<ResultSet>& result_set) {
+    try {
+        auto response_opt = transport_.complete(
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) {
+                return transport_.to_execute_query(response_message);
+            }, query_index);
+        if (!response_opt) {
+            return ErrorCode::SERVER_FAILURE;
+        }
+        const auto& response = response_opt.value();
+        result_set = std::make_shared<ResultSet>(
+            std::make_unique<ResultSet::Impl>(
+                this,
+                transport_.create_resultset_wire(response.name()),
+                response.record_meta(),
+                query_index
+            )
+        );
+        return ErrorCode::OK;
+    } catch (std::runtime_error &e) {
+        return ErrorCode::SERVER_ERROR;
+    }
+}
 
 /**
  * @brief execute a prepared statement.
@@ -199,29 +184,15 @@ ErrorCode Transaction::Impl::execute_statement(PreparedStatementPtr& prepared, c
             return ErrorCode::INVALID_PARAMETER;
         }
 
-        ::jogasaki::proto::sql::request::ExecutePreparedStatement request{};
-        *(request.mutable_transaction_handle()) = transaction_handle_;
-
-        ::jogasaki::proto::sql::common::PreparedStatement prepaed_statement{};
-        prepaed_statement.set_handle(ps_impl->get_id());
-        prepaed_statement.set_has_result_records(ps_impl->has_result_records());
-        *(request.mutable_prepared_statement_handle()) = prepaed_statement;
-
-        for (auto& e : parameters) {
-            *(request.add_parameters()) = std::visit(parameter(e.first), e.second);
-        }
         try {
-            auto response_opt = transport_.send(request);
-        
-            if (!response_opt) {
+            // build the request and read the response in place, to avoid copies
+            tateyama::common::wire::message_header::index_type slot_index{};
+            if (auto res = transport_.post([this, ps_impl, &parameters](::jogasaki::proto::sql::request::Request& req) {
+                    build_execute_prepared_statement(req, ps_impl, parameters);
+                }, slot_index); !res) {
                 return ErrorCode::SERVER_FAILURE;
             }
-            const auto& response = response_opt.value();
-            if (response.has_success()) {
-                num_rows = num_rows_processed(response.success());
-                return ErrorCode::OK;
-            }
-            return ErrorCode::SERVER_ERROR;
+            return complete_execute_statement(slot_index, num_rows);
         } catch (std::runtime_error &e) {
             return ErrorCode::SERVER_ERROR;
         }
@@ -278,33 +249,515 @@ ErrorCode Transaction::Impl::execute_query(PreparedStatementPtr& prepared, const
         if (!ps_impl->has_result_records()) {
             return ErrorCode::INVALID_PARAMETER;
         }
-        
-        ::jogasaki::proto::sql::request::ExecutePreparedQuery request{};
-        *(request.mutable_transaction_handle()) = transaction_handle_;
 
-        ::jogasaki::proto::sql::common::PreparedStatement prepaed_statement{};
-        prepaed_statement.set_handle(ps_impl->get_id());
-        prepaed_statement.set_has_result_records(ps_impl->has_result_records());
-        *(request.mutable_prepared_statement_handle()) = prepaed_statement;
         try {
-            for (auto& e : parameters) {
-                *(request.add_parameters()) = std::visit(parameter(e.first), e.second);
+            tateyama::common::wire::message_header::index_type query_index{};
+            if (auto res = transport_.post([this, ps_impl, &parameters](::jogasaki::proto::sql::request::Request& req) {
+                    build_execute_prepared_query(req, ps_impl, parameters);
+                }, query_index); !res) {
+                return ErrorCode::SERVER_FAILURE;
+            }
+            return complete_execute_query(query_index, result_set);
+        } catch (std::runtime_error &e) {
+            return ErrorCode::SERVER_ERROR;
+        }
+    }
+    return ErrorCode::NO_TRANSACTION;
+}
+
+/**
+ * @brief execute a prepared statement with the parameters bound, sending the request of the binder as is.
+ * @param binder the parameters bound to the prepared statement
+ * @return error code defined in error_code.h
+ */
+ErrorCode Transaction::Impl::execute_statement(ParameterBinder::Impl* binder, std::size_t& num_rows) {
+    if (alive_) {
+        if (binder->has_result_records()) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+
+        try {
+            tateyama::common::wire::message_header::index_type slot_index{};
+            if (auto res = transport_.post([this, binder](::jogasaki::proto::sql::request::Request& req) {
+                    req.unsafe_arena_set_allocated_execute_prepared_statement(binder->statement(transaction_handle_));
+                }, slot_index); !res) {
+                return ErrorCode::SERVER_FAILURE;
             }
+            return complete_execute_statement(slot_index, num_rows);
+        } catch (std::runtime_error &e) {
+            return ErrorCode::SERVER_ERROR;
+        }
+    }
+    return ErrorCode::NO_TRANSACTION;
+}
+
+/**
+ * @brief execute a prepared query with the parameters bound, sending the request of the binder as is.
+ * @param binder the parameters bound to the prepared query
+ * @return error code defined in error_code.h
+ */
+ErrorCode Transaction::Impl::execute_query(ParameterBinder::Impl* binder, std::shared_ptr<ResultSet> &result_set) {
+    if (alive_) {
+        if (!binder->has_result_records()) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+
+        try {
             tateyama::common::wire::message_header::index_type query_index{};
-            auto response_opt = transport_.send(request, query_index);
+            if (auto res = transport_.post([this, binder](::jogasaki::proto::sql::request::Request& req) {
+                    req.unsafe_arena_set_allocated_execute_prepared_query(binder->query(transaction_handle_));
+                }, query_index); !res) {
+                return ErrorCode::SERVER_FAILURE;
+            }
+            return complete_execute_query(query_index, result_set);
+        } catch (std::runtime_error &e) {
+            return ErrorCode::SERVER_ERROR;
+        }
+    }
+    return ErrorCode::NO_TRANSACTION;
+}
+
+/**
+ * @brief execute a prepared statement for each of the parameter sets, splitting them into batch requests
+ *  each of which the request wire takes at once.
+ * @param prepared statement object
+ * @param parameter_sets the parameter sets
+ * @return error code defined in error_code.h
+ */
+ErrorCode Transaction::Impl::execute_batch(PreparedStatementPtr& prepared, const std::vector<parameters_type>& parameter_sets, std::size_t& num_rows) {
+    if (alive_) {
+        auto* ps_impl = prepared->get_impl();
+
+        if (ps_impl->has_result_records()) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+
+        num_rows = 0;
+        try {
+            ::jogasaki::proto::sql::request::Batch request{};
+            *(request.mutable_transaction_handle()) = transaction_handle_;
+            auto* prepaed_statement = request.mutable_prepared_statement_handle();
+            prepaed_statement->set_handle(ps_impl->get_id());
+            prepaed_statement->set_has_result_records(false);
+            auto capacity = transport_.max_request_length();
+            auto fits = [this, capacity](std::size_t batch_size) {
+                return transport_.request_length(::jogasaki::proto::sql::request::Request::kBatchFieldNumber, batch_size) <= capacity;
+            };
+            auto set_tag_size = google::protobuf::io::CodedOutputStream::VarintSize32(
+                static_cast<google::protobuf::uint32>(::jogasaki::proto::sql::request::Batch::kParameterSetsFieldNumber) << 3U);
+
+            // each parameter set is built aside to see if it fits, and then swapped in
+            ::jogasaki::proto::sql::request::ParameterSet parameter_set{};
+            auto base = request.ByteSizeLong();
+            auto size = base;
+            for (auto& parameters : parameter_sets) {
+                parameter_set.Clear();
+                for (auto& e : parameters) {
+                    std::visit(parameter(parameter_set.add_elements(), e.first), e.second);
+                }
+                auto length = parameter_set.ByteSizeLong();
+                auto set_size = set_tag_size + google::protobuf::io::CodedOutputStream::VarintSize64(length) + length;
+                if (!fits(size + set_size) && request.parameter_sets_size() > 0) {
+                    if (auto rv = send_batch(request, num_rows); rv != ErrorCode::OK) {
+                        return rv;
+                    }
+                    request.clear_parameter_sets();  // the parameter sets cleared are reused
+                    size = base;
+                }
+                request.add_parameter_sets()->Swap(&parameter_set);
+                size += set_size;
+                if (!fits(size)) {
+                    // a parameter set too large for the request wire is sent alone, written piece by piece
+                    if (auto rv = send_batch(request, num_rows); rv != ErrorCode::OK) {
+                        return rv;
+                    }
+                    request.clear_parameter_sets();
+                    size = base;
+                }
+            }
+            if (request.parameter_sets_size() > 0) {
+                return send_batch(request, num_rows);
+            }
+            return ErrorCode::OK;
+        } catch (std::runtime_error &e) {
+            return ErrorCode::SERVER_ERROR;
+        }
+    }
+    return ErrorCode::NO_TRANSACTION;
+}
+
+/**
+ * @brief send a batch request and add the number of processes to num_rows.
+ */
+ErrorCode Transaction::Impl::send_batch(::jogasaki::proto::sql::request::Batch& request, std::size_t& num_rows) {
+    auto response_opt = transport_.send(request);
+    if (!response_opt) {
+        return ErrorCode::SERVER_FAILURE;
+    }
+    const auto& response = response_opt.value();
+    if (response.has_success()) {
+        num_rows += num_rows_processed(response.success());
+        return ErrorCode::OK;
+    }
+    return ErrorCode::SERVER_ERROR;
+}
+
+/**
+ * @brief execute a statement asynchronously.
+ * @param statement the SQL statement string
+ * @param num_rows a reference to a variable to which the number of processes, set when the future is resolved
+ * @return the future of the error code
+ */
+std::future<ErrorCode> Transaction::Impl::execute_statement_async(std::string_view statement, std::size_t& num_rows)
+{
+    if (!alive_) {
+        return make_ready(ErrorCode::NO_TRANSACTION);
+    }
+    tateyama::common::wire::message_header::index_type slot_index{};
+    try {
+        if (auto res = transport_.post([this, statement](::jogasaki::proto::sql::request::Request& req) {
+                auto* request = req.mutable_execute_statement();
+                *(request->mutable_transaction_handle()) = transaction_handle_;
+                request->set_sql(statement.data(), statement.length());
+            }, slot_index); !res) {
+            return make_ready(ErrorCode::SERVER_FAILURE);
+        }
+    } catch (std::runtime_error &e) {
+        return make_ready(ErrorCode::SERVER_ERROR);
+    }
+    return make_deferred([this, slot_index, &num_rows](bool deliver) {
+        std::size_t rows{};
+        auto rv = complete_execute_statement(slot_index, rows);
+        if (deliver) {
+            num_rows = rows;
+        }
+        return rv;
+    });
+}
+
+/**
+ * @brief execute a prepared statement asynchronously.
+ * @param prepared statement object with parameters
+ * @param num_rows a reference to a variable to which the number of processes, set when the future is resolved
+ * @return the future of the error code
+ */
+std::future<ErrorCode> Transaction::Impl::execute_statement_async(PreparedStatementPtr& prepared, const parameters_type& parameters, std::size_t& num_rows)
+{
+    if (!alive_) {
+        return make_ready(ErrorCode::NO_TRANSACTION);
+    }
+    auto* ps_impl = prepared->get_impl();
+    if (ps_impl->has_result_records()) {
+        return make_ready(ErrorCode::INVALID_PARAMETER);
+    }
+    tateyama::common::wire::message_header::index_type slot_index{};
+    try {
+        if (auto res = transport_.post([this, ps_impl, &parameters](::jogasaki::proto::sql::request::Request& req) {
+                build_execute_prepared_statement(req, ps_impl, parameters);
+            }, slot_index); !res) {
+            return make_ready(ErrorCode::SERVER_FAILURE);
+        }
+    } catch (std::runtime_error &e) {
+        return make_ready(ErrorCode::SERVER_ERROR);
+    }
+    return make_deferred([this, slot_index, &num_rows](bool deliver) {
+        std::size_t rows{};
+        auto rv = complete_execute_statement(slot_index, rows);
+        if (deliver) {
+            num_rows = rows;
+        }
+        return rv;
+    });
+}
+
+/**
+ * @brief execute a query asynchronously.
+ * @param query the SQL query string
+ * @param result_set returns a result set of the query when the future is resolved
+ * @return the future of the error code
+ */
+std::future<ErrorCode> Transaction::Impl::execute_query_async(std::string_view query, std::shared_ptr<ResultSet> &result_set)
+{
+    if (!alive_) {
+        return make_ready(ErrorCode::NO_TRANSACTION);
+    }
+    tateyama::common::wire::message_header::index_type query_index{};
+    try {
+        if (auto res = transport_.post([this, query](::jogasaki::proto::sql::request::Request& req) {
+                auto* request = req.mutable_execute_query();
+                *(request->mutable_transaction_handle()) = transaction_handle_;
+                request->set_sql(query.data(), query.length());
+            }, query_index); !res) {
+            return make_ready(ErrorCode::SERVER_FAILURE);
+        }
+    } catch (std::runtime_error &e) {
+        return make_ready(ErrorCode::SERVER_ERROR);
+    }
+    return make_deferred([this, query_index, &result_set](bool deliver) {
+        std::shared_ptr<ResultSet> rs{};
+        auto rv = complete_execute_query(query_index, rs);
+        if (deliver) {
+            result_set = std::move(rs);
+        }
+        return rv;
+    });
+}
+
+/**
+ * @brief execute a prepared query asynchronously.
+ * @param prepared statement object with parameters
+ * @param result_set returns a result set of the query when the future is resolved
+ * @return the future of the error code
+ */
+std::future<ErrorCode> Transaction::Impl::execute_query_async(PreparedStatementPtr& prepared, const parameters_type& parameters, std::shared_ptr<ResultSet> &result_set)
+{
+    if (!alive_) {
+        return make_ready(ErrorCode::NO_TRANSACTION);
+    }
+    auto* ps_impl = prepared->get_impl();
+    if (!ps_impl->has_result_records()) {
+        return make_ready(ErrorCode::INVALID_PARAMETER);
+    }
+    tateyama::common::wire::message_header::index_type query_index{};
+    try {
+        if (auto res = transport_.post([this, ps_impl, &parameters](::jogasaki::proto::sql::request::Request& req) {
+                build_execute_prepared_query(req, ps_impl, parameters);
+            }, query_index); !res) {
+            return make_ready(ErrorCode::SERVER_FAILURE);
+        }
+    } catch (std::runtime_error &e) {
+        return make_ready(ErrorCode::SERVER_ERROR);
+    }
+    return make_deferred([this, query_index, &result_set](bool deliver) {
+        std::shared_ptr<ResultSet> rs{};
+        auto rv = complete_execute_query(query_index, rs);
+        if (deliver) {
+            result_set = std::move(rs);
+        }
+        return rv;
+    });
+}
+
+/**
+ * @brief load the files on the server by executing a prepared statement for each of their rows.
+ * @param prepared statement object
+ * @param files the paths of the files
+ * @param column_mapping the columns of the files for the placeholders
+ * @return error code defined in error_code.h
+ */
+ErrorCode Transaction::Impl::execute_load(PreparedStatementPtr& prepared, const std::vector<std::string>& files, const column_mapping_type& column_mapping, std::size_t& num_rows)
+{
+    if (alive_) {
+        auto* ps_impl = prepared->get_impl();
+
+        if (ps_impl->has_result_records()) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+
+        num_rows = 0;
+        if (files.empty()) {
+            return ErrorCode::OK;
+        }
+        try {
+            tateyama::common::wire::message_header::index_type slot_index{};
+            if (auto res = transport_.post([this, ps_impl, &files, &column_mapping](::jogasaki::proto::sql::request::Request& req) {
+                    auto* request = req.mutable_execute_load();
+                    *(request->mutable_transaction_handle()) = transaction_handle_;
+                    auto* prepaed_statement = request->mutable_prepared_statement_handle();
+                    prepaed_statement->set_handle(ps_impl->get_id());
+                    prepaed_statement->set_has_result_records(false);
+                    for (auto& e : column_mapping) {
+                        auto* parameter = request->add_parameters();
+                        parameter->set_name(e.first);
+                        if (const auto* position = std::get_if<std::size_t>(&e.second); position != nullptr) {
+                            parameter->set_reference_column_position(*position);
+                        } else {
+                            parameter->set_reference_column_name(std::get<std::string>(e.second));
+                        }
+                    }
+                    for (auto& file : files) {
+                        request->add_file(file);
+                    }
+                }, slot_index); !res) {
+                return ErrorCode::SERVER_FAILURE;
+            }
+            auto response_opt = transport_.complete(
+                [this](const ::jogasaki::proto::sql::response::Response& response_message) {
+                    return transport_.to_execute_result_or_result_only(response_message);
+                }, slot_index);
             if (!response_opt) {
                 return ErrorCode::SERVER_FAILURE;
             }
             const auto& response = response_opt.value();
-            result_set = std::make_shared<ResultSet>(
-                std::make_unique<ResultSet::Impl>(
-                    this,
-                    transport_.create_resultset_wire(response.name()),
-                    response.record_meta(),
-                    query_index
-                )
-            );
-            return ErrorCode::OK;
+            if (response.has_success()) {
+                num_rows = num_rows_processed(response.success());
+                return ErrorCode::OK;
+            }
+            return ErrorCode::SERVER_ERROR;
+        } catch (std::runtime_error &e) {
+            return ErrorCode::SERVER_ERROR;
+        }
+    }
+    return ErrorCode::NO_TRANSACTION;
+}
+
+/**
+ * @brief set the dump option given by the ptree to the message.
+ * @return false if the option is not valid
+ */
+static bool set_dump_option(const boost::property_tree::ptree& option, ::jogasaki::proto::sql::request::DumpOption* dump_option)  //NOLINT(readability-function-cognitive-complexity)
+{
+    if (auto behavior = option.get_optional<std::int64_t>(DUMP_FAIL_BEHAVIOR); behavior) {
+        dump_option->set_fail_behavior(static_cast<::jogasaki::proto::sql::request::DumpFailBehavior>(behavior.value()));
+    }
+    if (auto count = option.get_optional<std::uint64_t>(MAX_RECORD_COUNT_PER_FILE); count) {
+        dump_option->set_max_record_count_per_file(count.value());
+    }
+    if (auto unit = option.get_optional<std::int64_t>(TIMESTAMP_UNIT); unit) {
+        dump_option->set_timestamp_unit(static_cast<::jogasaki::proto::sql::common::TimeUnit>(unit.value()));
+    }
+
+    auto parquet = option.get_child_optional(PARQUET);
+    auto arrow = option.get_child_optional(ARROW);
+    if (parquet && arrow) {
+        return false;
+    }
+    if (parquet) {
+        auto* format = dump_option->mutable_parquet();
+        const auto& node = parquet.value();
+        if (auto version = node.get_optional<std::string>(PARQUET_VERSION); version) {
+            format->set_parquet_version(version.value());
+        }
+        if (auto size = node.get_optional<std::int64_t>(RECORD_BATCH_SIZE); size) {
+            format->set_record_batch_size(size.value());
+        }
+        if (auto size = node.get_optional<std::int64_t>(RECORD_BATCH_IN_BYTES); size) {
+            format->set_record_batch_in_bytes(size.value());
+        }
+        if (auto codec = node.get_optional<std::string>(CODEC); codec) {
+            format->set_codec(codec.value());
+        }
+        if (auto encoding = node.get_optional<std::string>(ENCODING); encoding) {
+            format->set_encoding(encoding.value());
+        }
+        if (auto columns = node.get_child_optional(COLUMNS); columns) {
+            for (const auto& column_node : columns.value()) {
+                auto name = column_node.second.get_optional<std::string>(COLUMN_NAME);
+                if (!name) {
+                    return false;
+                }
+                auto* column = format->add_columns();
+                column->set_name(name.value());
+                if (auto codec = column_node.second.get_optional<std::string>(CODEC); codec) {
+                    column->set_codec(codec.value());
+                }
+                if (auto encoding = column_node.second.get_optional<std::string>(ENCODING); encoding) {
+                    column->set_encoding(encoding.value());
+                }
+            }
+        }
+    }
+    if (arrow) {
+        auto* format = dump_option->mutable_arrow();
+        const auto& node = arrow.value();
+        if (auto version = node.get_optional<std::string>(METADATA_VERSION); version) {
+            format->set_metadata_version(version.value());
+        }
+        if (auto alignment = node.get_optional<std::int32_t>(ALIGNMENT); alignment) {
+            format->set_alignment(alignment.value());
+        }
+        if (auto size = node.get_optional<std::int64_t>(RECORD_BATCH_SIZE); size) {
+            format->set_record_batch_size(size.value());
+        }
+        if (auto size = node.get_optional<std::int64_t>(RECORD_BATCH_IN_BYTES); size) {
+            format->set_record_batch_in_bytes(size.value());
+        }
+        if (auto codec = node.get_optional<std::string>(CODEC); codec) {
+            format->set_codec(codec.value());
+        }
+        if (auto saving = node.get_optional<double>(MIN_SPACE_SAVING); saving) {
+            format->set_min_space_saving(saving.value());
+        }
+        if (auto type = node.get_optional<std::int64_t>(CHARACTER_FIELD_TYPE); type) {
+            format->set_character_field_type(static_cast<::jogasaki::proto::sql::request::ArrowCharacterFieldType>(type.value()));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief execute a query and dump its result into files on the server.
+ * @param query the SQL query string
+ * @param directory the directory in which the files are created
+ * @param option the dump option
+ * @param files returns a result set of the files created
+ * @return error code defined in error_code.h
+ */
+ErrorCode Transaction::Impl::execute_dump(std::string_view query, std::string_view directory, const boost::property_tree::ptree& option, std::shared_ptr<ResultSet>& files)
+{
+    if (alive_) {
+        ::jogasaki::proto::sql::request::DumpOption dump_option{};
+        if (!set_dump_option(option, &dump_option)) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+        try {
+            tateyama::common::wire::message_header::index_type query_index{};
+            if (auto res = transport_.post([this, query, directory, &dump_option](::jogasaki::proto::sql::request::Request& req) {
+                    auto* request = req.mutable_execute_dump_by_text();
+                    *(request->mutable_transaction_handle()) = transaction_handle_;
+                    request->set_sql(query.data(), query.length());
+                    request->set_directory(directory.data(), directory.length());
+                    request->unsafe_arena_set_allocated_option(&dump_option);
+                }, query_index); !res) {
+                return ErrorCode::SERVER_FAILURE;
+            }
+            return complete_execute_query(query_index, files);
+        } catch (std::runtime_error &e) {
+            return ErrorCode::SERVER_ERROR;
+        }
+    }
+    return ErrorCode::NO_TRANSACTION;
+}
+
+/**
+ * @brief execute a prepared query and dump its result into files on the server.
+ * @param prepared statement object
+ * @param parameters the parameters of the prepared statement
+ * @param directory the directory in which the files are created
+ * @param option the dump option
+ * @param files returns a result set of the files created
+ * @return error code defined in error_code.h
+ */
+ErrorCode Transaction::Impl::execute_dump(PreparedStatementPtr& prepared, const parameters_type& parameters, std::string_view directory, const boost::property_tree::ptree& option, std::shared_ptr<ResultSet>& files)
+{
+    if (alive_) {
+        auto* ps_impl = prepared->get_impl();
+
+        if (!ps_impl->has_result_records()) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+
+        ::jogasaki::proto::sql::request::DumpOption dump_option{};
+        if (!set_dump_option(option, &dump_option)) {
+            return ErrorCode::INVALID_PARAMETER;
+        }
+        try {
+            tateyama::common::wire::message_header::index_type query_index{};
+            if (auto res = transport_.post([this, ps_impl, &parameters, directory, &dump_option](::jogasaki::proto::sql::request::Request& req) {
+                    auto* request = req.mutable_execute_dump();
+                    *(request->mutable_transaction_handle()) = transaction_handle_;
+                    auto* prepaed_statement = request->mutable_prepared_statement_handle();
+                    prepaed_statement->set_handle(ps_impl->get_id());
+                    prepaed_statement->set_has_result_records(true);
+                    for (auto& e : parameters) {
+                        std::visit(parameter(request->add_parameters(), e.first), e.second);
+                    }
+                    request->set_directory(directory.data(), directory.length());
+                    request->unsafe_arena_set_allocated_option(&dump_option);
+                }, query_index); !res) {
+                return ErrorCode::SERVER_FAILURE;
+            }
+            return complete_execute_query(query_index, files);
         } catch (std::runtime_error &e) {
             return ErrorCode::SERVER_ERROR;
         }
@@ -314,29 +767,79 @@ ErrorCode Transaction::Impl::execute_query(PreparedStatementPtr& prepared, const
 
 /**
  * @brief commit the current transaction.
+ * @param option the commit option
  * @return error code defined in error_code.h
  */
-ErrorCode Transaction::Impl::commit()
+ErrorCode Transaction::Impl::commit(const commit_option& option)
 {
     if (alive_) {
-        ::jogasaki::proto::sql::request::Commit request{};
-        *(request.mutable_transaction_handle()) = transaction_handle_;
-        auto response_opt = transport_.send(request);
-        request.clear_transaction_handle();
+        tateyama::common::wire::message_header::index_type slot_index{};
+        auto res = post_commit(slot_index, option);
         alive_ = false;
-        if (!response_opt) {
+        if (!res) {
             return ErrorCode::SERVER_FAILURE;
         }
-        const auto& response = response_opt.value();
-        if (response.has_success()) {
-            return dispose_transaction();
-        }
-        dispose_transaction();
-        return ErrorCode::SERVER_ERROR;
+        return complete_commit(slot_index, option.auto_dispose);
     }
     return ErrorCode::NO_TRANSACTION;
 }
 
+/**
+ * @brief commit the current transaction asynchronously.
+ * @param option the commit option
+ * @return the future of the error code
+ */
+std::future<ErrorCode> Transaction::Impl::commit_async(const commit_option& option)
+{
+    if (alive_) {
+        tateyama::common::wire::message_header::index_type slot_index{};
+        auto res = post_commit(slot_index, option);
+        alive_ = false;
+        if (!res) {
+            return make_ready(ErrorCode::SERVER_FAILURE);
+        }
+        return make_deferred([this, slot_index, auto_dispose = option.auto_dispose](bool) {
+            return complete_commit(slot_index, auto_dispose);
+        });
+    }
+    return make_ready(ErrorCode::NO_TRANSACTION);
+}
+
+bool Transaction::Impl::post_commit(tateyama::common::wire::message_header::index_type& slot_index, const commit_option& option)
+{
+    return transport_.post([this, &option](::jogasaki::proto::sql::request::Request& req) {
+        auto* commit = req.mutable_commit();
+        *(commit->mutable_transaction_handle()) = transaction_handle_;
+        if (option.notification_type != COMMIT_STATUS_UNSPECIFIED || option.auto_dispose) {
+            auto* commit_option = commit->mutable_option();
+            commit_option->set_notification_type(static_cast<::jogasaki::proto::sql::request::CommitStatus>(option.notification_type));
+            commit_option->set_auto_dispose(option.auto_dispose);
+        }
+    }, slot_index);
+}
+
+ErrorCode Transaction::Impl::complete_commit(tateyama::common::wire::message_header::index_type slot_index, bool auto_dispose)
+{
+    auto rv = transport_.complete(
+        [this](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<bool> {
+            if (response_message.has_result_only()) {
+                const auto& response = response_message.result_only();
+                transport_.set_sql_error(response);
+                return response.has_success();
+            }
+            return std::nullopt;
+        }, slot_index);
+    if (!rv) {
+        return ErrorCode::SERVER_FAILURE;
+    }
+    if (rv.value()) {
+        // the server has disposed the transaction with the notification of the success
+        return auto_dispose ? ErrorCode::OK : dispose_transaction();
+    }
+    dispose_transaction();
+    return ErrorCode::SERVER_ERROR;
+}
+
 /**
  * @brief abort the current transaction.
  * @return error code defined in error_code.h
@@ -363,6 +866,11 @@ ErrorCode Transaction::Impl::rollback()
 
 ErrorCode Transaction::Impl::dispose_transaction()
 {
+    if (auto* queue = manager_->get_disposal_queue(); queue != nullptr) {
+        queue->dispose(transaction_handle_);
+        alive_ = false;
+        return ErrorCode::OK;
+    }
     ::jogasaki::proto::sql::request::DisposeTransaction request{};
     *(request.mutable_transaction_handle()) = transaction_handle_;
     auto response_opt = transport_.send(request);
@@ -417,14 +925,79 @@ ErrorCode Transaction::execute_query(PreparedStatementPtr& prepared, parameters_
     return impl_->execute_query(prepared, parameters, result_set);
 }
 
+ErrorCode Transaction::execute_statement(ParameterBinder& binder, std::size_t& num_rows)
+{
+    return impl_->execute_statement(binder.get_impl(), num_rows);
+}
+
+ErrorCode Transaction::execute_query(ParameterBinder& binder, std::shared_ptr<ResultSet> &result_set)
+{
+    return impl_->execute_query(binder.get_impl(), result_set);
+}
+
+ErrorCode Transaction::execute_batch(PreparedStatementPtr& prepared, const std::vector<parameters_type>& parameter_sets, std::size_t& num_rows)
+{
+    return impl_->execute_batch(prepared, parameter_sets, num_rows);
+}
+
+ErrorCode Transaction::execute_load(PreparedStatementPtr& prepared, const std::vector<std::string>& files, const column_mapping_type& column_mapping, std::size_t& num_rows)
+{
+    return impl_->execute_load(prepared, files, column_mapping, num_rows);
+}
+
+ErrorCode Transaction::execute_dump(std::string_view query, std::string_view directory, const boost::property_tree::ptree& option, std::shared_ptr<ResultSet>& files)
+{
+    return impl_->execute_dump(query, directory, option, files);
+}
+
+ErrorCode Transaction::execute_dump(PreparedStatementPtr& prepared, const parameters_type& parameters, std::string_view directory, const boost::property_tree::ptree& option, std::shared_ptr<ResultSet>& files)
+{
+    return impl_->execute_dump(prepared, parameters, directory, option, files);
+}
+
 ErrorCode Transaction::commit()
 {
     return impl_->commit();
 }
 
+ErrorCode Transaction::commit(const commit_option& option)
+{
+    return impl_->commit(option);
+}
+
 ErrorCode Transaction::rollback()
 {
     return impl_->rollback();
 }
 
+std::future<ErrorCode> Transaction::execute_statement_async(std::string_view statement, std::size_t& num_rows)
+{
+    return impl_->execute_statement_async(statement, num_rows);
+}
+
+std::future<ErrorCode> Transaction::execute_statement_async(PreparedStatementPtr& prepared, parameters_type& parameters, std::size_t& num_rows)
+{
+    return impl_->execute_statement_async(prepared, parameters, num_rows);
+}
+
+std::future<ErrorCode> Transaction::execute_query_async(std::string_view query, std::shared_ptr<ResultSet> &result_set)
+{
+    return impl_->execute_query_async(query, result_set);
+}
+
+std::future<ErrorCode> Transaction::execute_query_async(PreparedStatementPtr& prepared, parameters_type& parameters, std::shared_ptr<ResultSet> &result_set)
+{
+    return impl_->execute_query_async(prepared, parameters, result_set);
+}
+
+std::future<ErrorCode> Transaction::commit_async()
+{
+    return impl_->commit_async();
+}
+
+std::future<ErrorCode> Transaction::commit_async(const commit_option& option)
+{
+    return impl_->commit_async(option);
+}
+
 }  // namespace ogawayama::stub
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <future>
 #include <memory>
 #include <vector>
 #include <queue>
@@ -73,11 +74,68 @@ public:
      */
     ErrorCode execute_query(PreparedStatementPtr& prepared_statement, const parameters_type& parameters, std::shared_ptr<ResultSet> &result_set);
 
+    /**
+     * @brief execute a prepared statement with the parameters bound.
+     * @param binder the parameters bound to the prepared statement
+     * @param num_rows a reference to a variable to which the number of processes
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_statement(ParameterBinder::Impl* binder, std::size_t& num_rows);
+
+    /**
+     * @brief execute a prepared query with the parameters bound.
+     * @param binder the parameters bound to the prepared query
+     * @param result_set returns a result set of the query
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_query(ParameterBinder::Impl* binder, std::shared_ptr<ResultSet> &result_set);
+
+    /**
+     * @brief execute a prepared statement for each of the parameter sets by batch requests.
+     * @param pointer to the prepared statement
+     * @param parameter_sets the parameter sets to be used for the executions of the prepared statement
+     * @param num_rows a reference to a variable to which the total number of processes
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_batch(PreparedStatementPtr& prepared_statement, const std::vector<parameters_type>& parameter_sets, std::size_t& num_rows);
+
+    /**
+     * @brief load the files by executing a prepared statement for each of their rows.
+     * @param pointer to the prepared statement
+     * @param files the paths of the files on the server
+     * @param column_mapping the columns of the files to be used for the placeholders
+     * @param num_rows a reference to a variable to which the number of processes
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_load(PreparedStatementPtr& prepared_statement, const std::vector<std::string>& files, const column_mapping_type& column_mapping, std::size_t& num_rows);
+
+    /**
+     * @brief execute a query and dump its result into files.
+     * @param query the SQL query string
+     * @param directory the directory on the server in which the files are created
+     * @param option the dump option
+     * @param files returns a result set of the files created
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_dump(std::string_view query, std::string_view directory, const boost::property_tree::ptree& option, std::shared_ptr<ResultSet>& files);
+
+    /**
+     * @brief execute a prepared query and dump its result into files.
+     * @param pointer to the prepared statement
+     * @param the parameters to be used for execution of the prepared statement
+     * @param directory the directory on the server in which the files are created
+     * @param option the dump option
+     * @param files returns a result set of the files created
+     * @return error code defined in error_code.h
+     */
+    ErrorCode execute_dump(PreparedStatementPtr& prepared_statement, const parameters_type& parameters, std::string_view directory, const boost::property_tree::ptree& option, std::shared_ptr<ResultSet>& files);
+
     /**
      * @brief commit the current transaction.
+     * @param option the commit option, the transaction being disposed by another request unless auto_dispose
      * @return error code defined in error_code.h
      */
-    ErrorCode commit();
+    ErrorCode commit(const commit_option& option = commit_option{COMMIT_STATUS_UNSPECIFIED, false});
     
     /**
      * @brief abort the current transaction.
@@ -85,6 +143,47 @@ public:
      */
     ErrorCode rollback();
 
+    /**
+     * @brief execute a statement asynchronously.
+     * @param statement the SQL statement string
+     * @param num_rows a reference to a variable to which the number of processes
+     * @return the future of the error code
+     */
+    std::future<ErrorCode> execute_statement_async(std::string_view statement, std::size_t& num_rows);
+
+    /**
+     * @brief execute a prepared statement asynchronously.
+     * @param pointer to the prepared statement
+     * @param the parameters to be used for execution of the prepared statement
+     * @param num_rows a reference to a variable to which the number of processes
+     * @return the future of the error code
+     */
+    std::future<ErrorCode> execute_statement_async(PreparedStatementPtr& prepared_statement, const parameters_type& parameters, std::size_t& num_rows);
+
+    /**
+     * @brief execute a query asynchronously.
+     * @param query the SQL query string
+     * @param result_set returns a result set of the query
+     * @return the future of the error code
+     */
+    std::future<ErrorCode> execute_query_async(std::string_view query, std::shared_ptr<ResultSet> &result_set);
+
+    /**
+     * @brief execute a prepared query asynchronously.
+     * @param pointer to the prepared statement
+     * @param the parameters to be used for execution of the prepared statement
+     * @param result_set returns a result set of the query
+     * @return the future of the error code
+     */
+    std::future<ErrorCode> execute_query_async(PreparedStatementPtr& prepared_statement, const parameters_type& parameters, std::shared_ptr<ResultSet> &result_set);
+
+    /**
+     * @brief commit the current transaction asynchronously.
+     * @param option the commit option, the transaction being disposed by another request unless auto_dispose
+     * @return the future of the error code
+     */
+    std::future<ErrorCode> commit_async(const commit_option& option = commit_option{COMMIT_STATUS_UNSPECIFIED, false});
+
 private:
     Connection::Impl* manager_;
     tateyama::bootstrap::wire::transport& transport_;
@@ -104,6 +203,10 @@ private:
 
     void receive_body(std::size_t query_index) {
         put_query_index(query_index);
+        if (auto* queue = manager_->get_disposal_queue(); queue != nullptr) {
+            queue->receive_body(query_index);
+            return;
+        }
         auto body_opt = transport_.receive_body(query_index);
         if (!body_opt) {
             std::cerr << "error at " << __func__ << std::endl;  // NOLINT FIXME revise error handling
@@ -131,6 +234,14 @@ private:
     }
     ErrorCode dispose_transaction();
 
+    void build_execute_prepared_statement(::jogasaki::proto::sql::request::Request& req, PreparedStatement::Impl* ps_impl, const parameters_type& parameters);
+    void build_execute_prepared_query(::jogasaki::proto::sql::request::Request& req, PreparedStatement::Impl* ps_impl, const parameters_type& parameters);
+    ErrorCode send_batch(::jogasaki::proto::sql::request::Batch& request, std::size_t& num_rows);
+    ErrorCode complete_execute_statement(tateyama::common::wire::message_header::index_type slot_index, std::size_t& num_rows);
+    ErrorCode complete_execute_query(tateyama::common::wire::message_header::index_type query_index, std::shared_ptr<ResultSet>& result_set);
+    bool post_commit(tateyama::common::wire::message_header::index_type& slot_index, const commit_option& option);
+    ErrorCode complete_commit(tateyama::common::wire::message_header::index_type slot_index, bool auto_dispose);
+
     friend class ResultSet::Impl;
 };
 
@@ -17,12 +17,19 @@
 
 #include <sstream>
 #include <optional>
+#include <limits>
+#include <atomic>
+#include <type_traits>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <exception>
+#include <functional>
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <google/protobuf/arena.h>
+
 #include <tateyama/utils/protobuf_utils.h>
 #include <tateyama/proto/framework/request.pb.h>
 #include <tateyama/proto/framework/response.pb.h>
@@ -113,19 +120,18 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::Begin> send(::jogasaki::proto::sql::request::Begin& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_begin())= req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_begin();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_begin()) {
-                const auto& response = response_message.begin();
-                sql_error_ = response.has_error() ? response.error() : ::jogasaki::proto::sql::response::Error{};
-                return response;
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_begin(&req);
+            },
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::Begin> {
+                if (response_message.has_begin()) {
+                    const auto& response = response_message.begin();
+                    set_sql_error(response);
+                    return response;
+                }
+                return std::nullopt;
+            }, slot_index);
     }
 
 /**
@@ -135,19 +141,18 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::Prepare> send(::jogasaki::proto::sql::request::Prepare& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_prepare())= req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_prepare();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_prepare()) {
-                const auto& response = response_message.prepare();
-                sql_error_ = response.has_error() ? response.error() : ::jogasaki::proto::sql::response::Error{};
-                return response;
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_prepare(&req);
+            },
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::Prepare> {
+                if (response_message.has_prepare()) {
+                    const auto& response = response_message.prepare();
+                    set_sql_error(response);
+                    return response;
+                }
+                return std::nullopt;
+            }, slot_index);
     }
 
 /**
@@ -157,19 +162,13 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::ExecuteResult> send(::jogasaki::proto::sql::request::ExecuteStatement& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_execute_statement()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_execute_statement();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_execute_result()) {
-                const auto& response = response_message.execute_result();
-                sql_error_ = response.has_error() ? response.error() : ::jogasaki::proto::sql::response::Error{};
-                return response;
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_execute_statement(&req);
+            },
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) {
+                return to_execute_result(response_message);
+            }, slot_index);
     }
 
 /**
@@ -178,23 +177,13 @@ public:
  * @return std::optional of ::jogasaki::proto::sql::request::ExecuteQuery
  */
     std::optional<::jogasaki::proto::sql::response::ExecuteQuery> send(::jogasaki::proto::sql::request::ExecuteQuery& req, tateyama::common::wire::message_header::index_type& query_index) {
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_execute_query()) = req;
-
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, query_index);
-        request.clear_execute_query();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_execute_query()) {
-                return response_message.execute_query();
-            }
-            if (response_message.has_result_only()) {
-                const auto& response = response_message.result_only();
-                sql_error_ = response.has_error() ? response.error() : ::jogasaki::proto::sql::response::Error{};
-                throw std::runtime_error("no body_head message");
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_execute_query(&req);
+            },
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) {
+                return to_execute_query(response_message);
+            }, query_index);
     }
 
 /**
@@ -204,19 +193,13 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::ExecuteResult> send(::jogasaki::proto::sql::request::ExecutePreparedStatement& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_execute_prepared_statement()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_execute_prepared_statement();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_execute_result()) {
-                const auto& response = response_message.execute_result();
-                sql_error_ = response.has_error() ? response.error() : ::jogasaki::proto::sql::response::Error{};
-                return response;
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_execute_prepared_statement(&req);
+            },
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) {
+                return to_execute_result(response_message);
+            }, slot_index);
     }
 
 /**
@@ -225,22 +208,56 @@ public:
  * @return std::optional of ::jogasaki::proto::sql::request::ExecutePreparedQuery
  */
     std::optional<::jogasaki::proto::sql::response::ExecuteQuery> send(::jogasaki::proto::sql::request::ExecutePreparedQuery& req, tateyama::common::wire::message_header::index_type& query_index) {
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_execute_prepared_query()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, query_index);
-        request.clear_execute_prepared_query();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_execute_query()) {
-                return response_message.execute_query();
-            }
-            if (response_message.has_result_only()) {
-                const auto& response = response_message.result_only();
-                sql_error_ = response.has_error() ? response.error() : ::jogasaki::proto::sql::response::Error{};
-                throw std::runtime_error("no body_head message");
-            }
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_execute_prepared_query(&req);
+            },
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) {
+                return to_execute_query(response_message);
+            }, query_index);
+    }
+
+/**
+ * @brief send a batch request to the sql service.
+ * @param req the request message by protocol buffers
+ * @return std::optional of ::jogasaki::proto::sql::response::ExecuteResult, made from ResultOnly if the server responds with it
+ */
+    std::optional<::jogasaki::proto::sql::response::ExecuteResult> send(::jogasaki::proto::sql::request::Batch& req) {
+        tateyama::common::wire::message_header::index_type slot_index{};
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_batch(&req);
+            },
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) {
+                return to_execute_result_or_result_only(response_message);
+            }, slot_index);
+    }
+
+/**
+ * @brief get the length of the request wire message carrying a sql service request of the body given,
+ *  the framework header, the session handle, the tag of the body and the length prefixes included.
+ * @param field_number the field number of the body in ::jogasaki::proto::sql::request::Request
+ * @param body_size the serialized size of the body
+ */
+    [[nodiscard]] std::size_t request_length(int field_number, std::size_t body_size) {
+        if (sql_envelope_length_ == 0) {
+            ::jogasaki::proto::sql::request::Request request{};
+            request.set_service_message_version_major(SQL_MESSAGE_VERSION_MAJOR);
+            request.set_service_message_version_minor(SQL_MESSAGE_VERSION_MINOR);
+            *(request.mutable_session_handle()) = session_;
+            sql_envelope_length_ = request.ByteSizeLong();
+            header_length_ = delimited_size(header_.ByteSizeLong());
         }
-        return std::nullopt;
+        auto tag_size = google::protobuf::io::CodedOutputStream::VarintSize32(static_cast<google::protobuf::uint32>(field_number) << 3U);
+        return header_length_ + delimited_size(sql_envelope_length_ + tag_size + delimited_size(body_size));
+    }
+
+/**
+ * @brief get the maximum length of a request wire message that the request wire takes at once,
+ *  beyond which the message is written piece by piece as the server reads it.
+ */
+    [[nodiscard]] std::size_t max_request_length() const noexcept {
+        return wire_.max_request_length();
     }
 
 /**
@@ -258,19 +275,18 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::ResultOnly> send(::jogasaki::proto::sql::request::Commit& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_commit()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_commit();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_result_only()) {
-                const auto& response = response_message.result_only();
-                sql_error_ = response.has_error() ? response.error() : ::jogasaki::proto::sql::response::Error{};
-                return response;
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_commit(&req);
+            },
+            [this](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::ResultOnly> {
+                if (response_message.has_result_only()) {
+                    const auto& response = response_message.result_only();
+                    set_sql_error(response);
+                    return response;
+                }
+                return std::nullopt;
+            }, slot_index);
     }
 
 /**
@@ -280,17 +296,16 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::ResultOnly> send(::jogasaki::proto::sql::request::Rollback& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_rollback()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_rollback();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_result_only()) {
-                return response_message.result_only();
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_rollback(&req);
+            },
+            [](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::ResultOnly> {
+                if (response_message.has_result_only()) {
+                    return response_message.result_only();
+                }
+                return std::nullopt;
+            }, slot_index);
     }
 
 /**
@@ -300,26 +315,13 @@ public:
  */
     std::optional<ogawayama::stub::ErrorCode> send(::jogasaki::proto::sql::request::DisposePreparedStatement& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_dispose_prepared_statement()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_dispose_prepared_statement();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_result_only()) {
-                const auto& ro = response_message.result_only();
-                if (ro.has_success()) {
-                    return ogawayama::stub::ErrorCode::OK;
-                }
-            }
-            if (response_message.has_dispose_transaction()) {
-                const auto& ro = response_message.dispose_transaction();
-                if (ro.has_success()) {
-                    return ogawayama::stub::ErrorCode::OK;
-                }
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_dispose_prepared_statement(&req);
+            },
+            [](const ::jogasaki::proto::sql::response::Response& response_message) {
+                return to_dispose_result(response_message);
+            }, slot_index);
     }
 
 // Explain
@@ -333,17 +335,16 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::DescribeTable> send(::jogasaki::proto::sql::request::DescribeTable& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_describe_table()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_describe_table();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_describe_table()) {
-                return response_message.describe_table();
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_describe_table(&req);
+            },
+            [](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::DescribeTable> {
+                if (response_message.has_describe_table()) {
+                    return response_message.describe_table();
+                }
+                return std::nullopt;
+            }, slot_index);
     }
 
 // Batch
@@ -355,17 +356,16 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::ListTables> send(::jogasaki::proto::sql::request::ListTables& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_listtables()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_listtables();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_list_tables()) {
-                return response_message.list_tables();
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_listtables(&req);
+            },
+            [](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::ListTables> {
+                if (response_message.has_list_tables()) {
+                    return response_message.list_tables();
+                }
+                return std::nullopt;
+            }, slot_index);
     }
 
 /**
@@ -375,17 +375,16 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::GetSearchPath> send(::jogasaki::proto::sql::request::GetSearchPath& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_getsearchpath()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_getsearchpath();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_get_search_path()) {
-                return response_message.get_search_path();
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_getsearchpath(&req);
+            },
+            [](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::GetSearchPath> {
+                if (response_message.has_get_search_path()) {
+                    return response_message.get_search_path();
+                }
+                return std::nullopt;
+            }, slot_index);
     }
 
 /**
@@ -395,17 +394,16 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::GetErrorInfo> send(::jogasaki::proto::sql::request::GetErrorInfo& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_get_error_info()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_get_error_info();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_get_error_info()) {
-                return response_message.get_error_info();
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_get_error_info(&req);
+            },
+            [](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::GetErrorInfo> {
+                if (response_message.has_get_error_info()) {
+                    return response_message.get_error_info();
+                }
+                return std::nullopt;
+            }, slot_index);
     }
 
 /**
@@ -415,26 +413,13 @@ public:
  */
     std::optional<ogawayama::stub::ErrorCode> send(::jogasaki::proto::sql::request::DisposeTransaction& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_dispose_transaction()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_dispose_transaction();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_result_only()) {
-                const auto& ro = response_message.result_only();
-                if (ro.has_success()) {
-                    return ogawayama::stub::ErrorCode::OK;
-                }
-            }
-            if (response_message.has_dispose_transaction()) {
-                const auto& ro = response_message.dispose_transaction();
-                if (ro.has_success()) {
-                    return ogawayama::stub::ErrorCode::OK;
-                }
-            }
-        }
-        return std::nullopt;
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_dispose_transaction(&req);
+            },
+            [](const ::jogasaki::proto::sql::response::Response& response_message) {
+                return to_dispose_result(response_message);
+            }, slot_index);
     }
 
 // ExplainByText
@@ -447,15 +432,113 @@ public:
  */
     std::optional<::jogasaki::proto::sql::response::GetLargeObjectData> send(::jogasaki::proto::sql::request::GetLargeObjectData& req) {
         tateyama::common::wire::message_header::index_type slot_index{};
-        ::jogasaki::proto::sql::request::Request request{};
-        *(request.mutable_get_large_object_data()) = req;
-        auto response_opt = send<::jogasaki::proto::sql::response::Response>(request, slot_index);
-        request.clear_get_large_object_data();
-        if (response_opt) {
-            const auto& response_message = response_opt.value();
-            if (response_message.has_get_large_object_data()) {
-                return response_message.get_large_object_data();
+        return round_trip(
+            [&req](::jogasaki::proto::sql::request::Request& request) {
+                request.unsafe_arena_set_allocated_get_large_object_data(&req);
+            },
+            [](const ::jogasaki::proto::sql::response::Response& response_message) -> std::optional<::jogasaki::proto::sql::response::GetLargeObjectData> {
+                if (response_message.has_get_large_object_data()) {
+                    return response_message.get_large_object_data();
+                }
+                return std::nullopt;
+            }, slot_index);
+    }
+
+/**
+ * @brief send a request built in place in the per-connection arena and consume the response there.
+ *  The request and the response are valid only in the builder and the consumer respectively,
+ *  so a round trip does not allocate from the general heap in steady state.
+ * @param builder the function taking ::jogasaki::proto::sql::request::Request& to set a request
+ * @param consumer the function taking const ::jogasaki::proto::sql::response::Response& and returning std::optional
+ * @param slot_index returns the slot index used
+ * @return the value returned by the consumer, std::nullopt if the request cannot be sent or the response cannot be parsed
+ */
+    template <typename B, typename C>
+    std::invoke_result_t<C, const ::jogasaki::proto::sql::response::Response&> round_trip(B&& builder, C&& consumer, tateyama::common::wire::message_header::index_type& slot_index) {
+        if (auto res = post(std::forward<B>(builder), slot_index); ! res) {
+            return std::nullopt;
+        }
+        return complete(std::forward<C>(consumer), slot_index);
+    }
+
+/**
+ * @brief send a request built in place in the per-connection arena without waiting for the response,
+ *  which must be received later by complete() with the slot index returned.
+ * @param builder the function taking ::jogasaki::proto::sql::request::Request& to set a request
+ * @param slot_index returns the slot index used
+ * @return false if the request cannot be sent
+ */
+    template <typename B>
+    bool post(B&& builder, tateyama::common::wire::message_header::index_type& slot_index) {
+        arena_lease lease{*this};
+        auto* request = google::protobuf::Arena::CreateMessage<::jogasaki::proto::sql::request::Request>(lease.get());
+        builder(*request);
+        request->set_service_message_version_major(SQL_MESSAGE_VERSION_MAJOR);
+        request->set_service_message_version_minor(SQL_MESSAGE_VERSION_MINOR);
+        *(request->mutable_session_handle()) = session_;
+        return send_message(header_, *request, slot_index);
+    }
+
+/**
+ * @brief receive the response of a request sent by post() and consume it in the per-connection arena.
+ * @param consumer the function taking const ::jogasaki::proto::sql::response::Response& and returning std::optional
+ * @param slot_index the slot index returned by post()
+ * @return the value returned by the consumer, std::nullopt if the response cannot be parsed
+ */
+    template <typename C>
+    std::invoke_result_t<C, const ::jogasaki::proto::sql::response::Response&> complete(C&& consumer, tateyama::common::wire::message_header::index_type slot_index) {
+        arena_lease lease{*this};
+        auto* response = google::protobuf::Arena::CreateMessage<::jogasaki::proto::sql::response::Response>(lease.get());
+        if(auto res = receive(*response, slot_index); ! res) {
+            return std::nullopt;
+        }
+        return consumer(*response);
+    }
+
+/**
+ * @brief set the error in the response given as the last sql error.
+ */
+    template <typename T>
+    void set_sql_error(const T& response) {
+        if (response.has_error()) {
+            sql_error_ = response.error();
+        } else {
+            sql_error_.Clear();
+        }
+    }
+
+/**
+ * @brief consumers of the responses, for round_trip() and complete().
+ */
+    std::optional<::jogasaki::proto::sql::response::ExecuteResult> to_execute_result(const ::jogasaki::proto::sql::response::Response& response_message) {
+        if (response_message.has_execute_result()) {
+            const auto& response = response_message.execute_result();
+            set_sql_error(response);
+            return response;
+        }
+        return std::nullopt;
+    }
+    std::optional<::jogasaki::proto::sql::response::ExecuteResult> to_execute_result_or_result_only(const ::jogasaki::proto::sql::response::Response& response_message) {
+        if (response_message.has_result_only()) {
+            const auto& response = response_message.result_only();
+            set_sql_error(response);
+            ::jogasaki::proto::sql::response::ExecuteResult result{};
+            if (response.has_error()) {
+                *(result.mutable_error()) = response.error();
+            } else {
+                (void) result.mutable_success();
             }
+            return result;
+        }
+        return to_execute_result(response_message);
+    }
+    std::optional<::jogasaki::proto::sql::response::ExecuteQuery> to_execute_query(const ::jogasaki::proto::sql::response::Response& response_message) {
+        if (response_message.has_execute_query()) {
+            return response_message.execute_query();
+        }
+        if (response_message.has_result_only()) {
+            set_sql_error(response_message.result_only());
+            throw std::runtime_error("no body_head message");
         }
         return std::nullopt;
     }
@@ -465,6 +548,17 @@ public:
         closed_ = true;
     }
 
+/**
+ * @brief set the handler called when a request finds no free slot, to release the slots held by
+ *  the requests whose responses have not been received yet. The slot is searched again after it returns.
+ *  The handler is called only on the threads sending the requests of the connection,
+ *  never on the timer thread updating the expiration time.
+ * @param handler the handler, which is not called again while it is running, or an empty one to clear it
+ */
+    void set_slot_shortage_handler(std::function<void()> handler) {
+        slot_shortage_handler_ = std::move(handler);
+    }
+
     std::unique_ptr<tateyama::common::wire::session_wire_container::resultset_wires_container> create_resultset_wire(std::string_view name) {
         auto rw = wire_.create_resultset_wire();
         try {
@@ -507,30 +601,71 @@ private:
     std::vector<std::string> query_results_{};
     bool closed_{};
     std::unique_ptr<tateyama::common::wire::timer> timer_{};
+    std::function<void()> slot_shortage_handler_{};
+    std::size_t sql_envelope_length_{};  // the serialized size of the sql request other than the body, set on first use
+    std::size_t header_length_{};        // the size of the framework header delimited, set with sql_envelope_length_
+    bool in_slot_shortage_handler_{};
     std::string encrypted_credential_{};
     ::tateyama::proto::framework::response::Header response_header_{};
     ::jogasaki::proto::sql::response::Error sql_error_{};
     ::tateyama::proto::diagnostics::Record framework_error_{};
 
-    template <typename T>
-    std::optional<T> send(::jogasaki::proto::sql::request::Request& request, tateyama::common::wire::message_header::index_type& slot_index) {
-        std::stringstream ss{};
-        if(auto res = tateyama::utils::SerializeDelimitedToOstream(header_, std::addressof(ss)); ! res) {
-            return std::nullopt;
+    /**
+     * @brief lends the per-connection arena, reset on each lease,
+     *  or a temporary arena if it is in use by another round trip.
+     */
+    class arena_lease {
+    public:
+        explicit arena_lease(transport& envelope) : envelope_(envelope) {
+            if (!envelope_.arena_in_use_.test_and_set()) {
+                envelope_.arena_.Reset();
+                arena_ = &envelope_.arena_;
+            } else {
+                arena_ = &local_arena_.emplace();
+            }
         }
-        request.set_service_message_version_major(SQL_MESSAGE_VERSION_MAJOR);
-        request.set_service_message_version_minor(SQL_MESSAGE_VERSION_MINOR);
-        auto session_handle = request.mutable_session_handle();
-        *session_handle = session_;
-        if(auto res = tateyama::utils::SerializeDelimitedToOstream(request, std::addressof(ss)); ! res) {
-            request.clear_session_handle();
-            return std::nullopt;
+        ~arena_lease() {
+            if (arena_ == &envelope_.arena_) {
+                envelope_.arena_in_use_.clear();
+            }
         }
-        slot_index = wire_.search_slot();
-        wire_.send(ss.str(), slot_index);
-        request.clear_session_handle();
+        arena_lease(arena_lease const&) = delete;
+        arena_lease(arena_lease&&) = delete;
+        arena_lease& operator = (arena_lease const&) = delete;
+        arena_lease& operator = (arena_lease&&) = delete;
 
-        return receive<T>(slot_index);
+        [[nodiscard]] google::protobuf::Arena* get() const noexcept { return arena_; }
+
+    private:
+        transport& envelope_;
+        google::protobuf::Arena* arena_{};
+        std::optional<google::protobuf::Arena> local_arena_{};
+    };
+
+    static constexpr std::size_t arena_initial_block_size = 64UL * 1024UL;
+    std::unique_ptr<char[]> arena_block_{std::make_unique<char[]>(arena_initial_block_size)};  // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+    google::protobuf::Arena arena_{arena_options(arena_block_.get())};
+    std::atomic_flag arena_in_use_ = ATOMIC_FLAG_INIT;
+
+    static google::protobuf::ArenaOptions arena_options(char* block) {
+        google::protobuf::ArenaOptions options{};
+        options.initial_block = block;
+        options.initial_block_size = arena_initial_block_size;
+        return options;
+    }
+
+    static std::optional<ogawayama::stub::ErrorCode> to_dispose_result(const ::jogasaki::proto::sql::response::Response& response_message) {
+        if (response_message.has_result_only()) {
+            if (response_message.result_only().has_success()) {
+                return ogawayama::stub::ErrorCode::OK;
+            }
+        }
+        if (response_message.has_dispose_transaction()) {
+            if (response_message.dispose_transaction().has_success()) {
+                return ogawayama::stub::ErrorCode::OK;
+            }
+        }
+        return std::nullopt;
     }
 
     template <typename T>
@@ -540,17 +675,13 @@ private:
         fwrq_header.set_service_message_version_minor(HEADER_MESSAGE_VERSION_MINOR);
         fwrq_header.set_service_id(SERVICE_ID_ROUTING);
 
-        std::stringstream sst{};
-        if(auto res = tateyama::utils::SerializeDelimitedToOstream(fwrq_header, std::addressof(sst)); ! res) {
-            return std::nullopt;
-        }
         request.set_service_message_version_major(CORE_MESSAGE_VERSION_MAJOR);
         request.set_service_message_version_minor(CORE_MESSAGE_VERSION_MINOR);
-        if(auto res = tateyama::utils::SerializeDelimitedToOstream(request, std::addressof(sst)); ! res) {
+        tateyama::common::wire::message_header::index_type slot_index{};
+        // sent by the timer thread, on which the slot shortage handler must not run
+        if(auto res = send_message(fwrq_header, request, slot_index, false); ! res) {
             return std::nullopt;
         }
-        auto slot_index = wire_.search_slot();
-        wire_.send(sst.str(), slot_index);
         return receive<T>(slot_index);
     }
 
@@ -561,54 +692,93 @@ private:
         fwrq_header.set_service_message_version_minor(HEADER_MESSAGE_VERSION_MINOR);
         fwrq_header.set_service_id(SERVICE_ID_ENDPOINT_BROKER);
 
-        std::stringstream sst{};
-        if(auto res = tateyama::utils::SerializeDelimitedToOstream(fwrq_header, std::addressof(sst)); ! res) {
-            return std::nullopt;
-        }
         request.set_service_message_version_major(ENDPOINT_MESSAGE_VERSION_MAJOR);
         request.set_service_message_version_minor(ENDPOINT_MESSAGE_VERSION_MINOR);
-        if(auto res = tateyama::utils::SerializeDelimitedToOstream(request, std::addressof(sst)); ! res) {
+        tateyama::common::wire::message_header::index_type slot_index{};
+        if(auto res = send_message(fwrq_header, request, slot_index); ! res) {
             return std::nullopt;
         }
-        auto slot_index = wire_.search_slot();
-        wire_.send(sst.str(), slot_index);
         return receive<T>(slot_index);
     }
 
     template <typename T>
-    std::optional<T> receive(tateyama::common::wire::message_header::index_type slot_index) { //NOLINT(readability-function-cognitive-complexity)
-        while (true) {
-            std::string response_message{};
-            wire_.receive(response_message, slot_index);
-
-            response_header_ = ::tateyama::proto::framework::response::Header{};
-            google::protobuf::io::ArrayInputStream in{response_message.data(), static_cast<int>(response_message.length())};
-            if(auto res = tateyama::utils::ParseDelimitedFromZeroCopyStream(std::addressof(response_header_), std::addressof(in), nullptr); ! res) {
-                return std::nullopt;
-            }
-            if (response_header_.payload_type() == ::tateyama::proto::framework::response::Header_PayloadType::Header_PayloadType_SERVER_DIAGNOSTICS) {
-                std::string_view record{};
-                if (auto res = tateyama::utils::GetDelimitedBodyFromZeroCopyStream(std::addressof(in), nullptr, record); ! res) {
-                    return std::nullopt;
-                }
-                if(auto res = framework_error_.ParseFromArray(record.data(), static_cast<int>(record.length())); ! res) {
-                    return std::nullopt;
-                }
-                throw std::runtime_error("received SERVER_DIAGNOSTICS");
-            }
-            if (response_header_.payload_type() != ::tateyama::proto::framework::response::Header_PayloadType::Header_PayloadType_SERVICE_RESULT) {
-                throw std::runtime_error("unknown payload type");
-            }
+    std::optional<T> receive(tateyama::common::wire::message_header::index_type slot_index) {
+        T response{};
+        if (auto res = receive(response, slot_index); ! res) {
+            return std::nullopt;
+        }
+        return response;
+    }
+
+    /**
+     * @brief receive the response for the slot and parse it into the message given.
+     * @return false if the response cannot be parsed
+     */
+    bool receive(google::protobuf::MessageLite& response, tateyama::common::wire::message_header::index_type slot_index) {
+        bool parsed{};
+        bool diagnostics{};
+        bool unknown{};
+        wire_.receive([this, &response, &parsed, &diagnostics, &unknown](std::string_view response_message){
             std::string_view payload{};
-            if (auto res = tateyama::utils::GetDelimitedBodyFromZeroCopyStream(std::addressof(in), nullptr, payload); ! res) {
-                return std::nullopt;
+            switch (parse_response_header(response_message, payload)) {
+            case payload_status::service_result:
+                break;
+            case payload_status::server_diagnostics:
+                diagnostics = true;
+                return;
+            case payload_status::unknown:
+                unknown = true;
+                return;
+            case payload_status::error:
+                return;
             }
-            T response{};
-            if(auto res = response.ParseFromArray(payload.data(), payload.length()); ! res) {
-                return std::nullopt;
+            parsed = response.ParseFromArray(payload.data(), static_cast<int>(payload.length()));
+        }, slot_index);
+
+        if (diagnostics) {
+            throw std::runtime_error("received SERVER_DIAGNOSTICS");
+        }
+        if (unknown) {
+            throw std::runtime_error("unknown payload type");
+        }
+        return parsed;
+    }
+
+    enum class payload_status {
+        service_result,
+        server_diagnostics,
+        unknown,
+        error,
+    };
+
+    /**
+     * @brief parse the framework header of the response message, and provide the view of the payload
+     *  or parse the diagnostics into framework_error_, does not throw as the message may be in the response wire.
+     */
+    payload_status parse_response_header(std::string_view response_message, std::string_view& payload) {
+        response_header_ = ::tateyama::proto::framework::response::Header{};
+        google::protobuf::io::ArrayInputStream in{response_message.data(), static_cast<int>(response_message.length())};
+        if(auto res = tateyama::utils::ParseDelimitedFromZeroCopyStream(std::addressof(response_header_), std::addressof(in), nullptr); ! res) {
+            return payload_status::error;
+        }
+        if (response_header_.payload_type() == ::tateyama::proto::framework::response::Header_PayloadType::Header_PayloadType_SERVER_DIAGNOSTICS) {
+            std::string_view record{};
+            if (auto res = tateyama::utils::GetDelimitedBodyFromZeroCopyStream(std::addressof(in), nullptr, record); ! res) {
+                return payload_status::error;
             }
-            return response;
+            if(auto res = framework_error_.ParseFromArray(record.data(), static_cast<int>(record.length())); ! res) {
+                return payload_status::error;
+            }
+            return payload_status::server_diagnostics;
         }
+        if (response_header_.payload_type() != ::tateyama::proto::framework::response::Header_PayloadType::Header_PayloadType_SERVICE_RESULT) {
+            return payload_status::unknown;
+        }
+        bool eof{};
+        if (auto res = tateyama::utils::GetDelimitedBodyFromZeroCopyStream(std::addressof(in), &eof, payload); ! res) {
+            return payload_status::error;
+        }
+        return payload_status::service_result;
     }
 
     std::string& query_results_at(std::size_t slot_index) {
@@ -616,19 +786,80 @@ private:
     }
 
     std::optional<std::string> send_bridge_request(std::string_view request) {
-        std::stringstream ss{};
-        if(auto res = tateyama::utils::SerializeDelimitedToOstream(bridge_header_, std::addressof(ss)); ! res) {
+        auto header_size = bridge_header_.ByteSizeLong();
+        auto length = delimited_size(header_size) + delimited_size(request.length());
+        if (length > max_message_length) {
             return std::nullopt;
         }
-        if(auto res = tateyama::utils::PutDelimitedBodyToOstream(request, std::addressof(ss)); ! res) {
-            return std::nullopt;
-        }
-        auto slot_index = wire_.search_slot();
-        wire_.send(ss.str(), slot_index);
+        auto slot_index = acquire_slot();
+        wire_.send(length, [this, header_size, request](char* top){
+            auto* ptr = reinterpret_cast<google::protobuf::uint8*>(top);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            ptr = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(static_cast<google::protobuf::uint32>(header_size), ptr);
+            ptr = bridge_header_.SerializeWithCachedSizesToArray(ptr);
+            ptr = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(static_cast<google::protobuf::uint32>(request.length()), ptr);
+            std::memcpy(ptr, request.data(), request.length());
+        }, slot_index);
 
         return receive(slot_index);
     }
 
+    static constexpr std::size_t max_message_length = std::numeric_limits<std::int32_t>::max();
+
+    /**
+     * @brief acquire a slot, calling the slot shortage handler before searching it by the slot policy when none is free.
+     * @return the index of the slot acquired
+     * @throws std::runtime_error if no slot is available
+     */
+    tateyama::common::wire::message_header::index_type acquire_slot() {
+        if (slot_shortage_handler_ && !in_slot_shortage_handler_) {
+            if (auto index = wire_.try_search_slot(); index) {
+                return index.value();
+            }
+            in_slot_shortage_handler_ = true;
+            try {
+                slot_shortage_handler_();
+            } catch (...) {
+                in_slot_shortage_handler_ = false;
+                throw;
+            }
+            in_slot_shortage_handler_ = false;
+        }
+        return wire_.search_slot();
+    }
+
+    static std::size_t delimited_size(std::size_t size) {
+        return google::protobuf::io::CodedOutputStream::VarintSize32(static_cast<google::protobuf::uint32>(size)) + size;
+    }
+
+    /**
+     * @brief serialize the framework header and the message delimited directly into the request wire.
+     * @param header the framework header
+     * @param message the service message
+     * @param slot_index returns the slot index used
+     * @param handle_shortage true if the slot shortage handler can be called, which is false on the timer thread
+     * @return false if the message is too large to be sent
+     */
+    bool send_message(const google::protobuf::MessageLite& header, const google::protobuf::MessageLite& message, tateyama::common::wire::message_header::index_type& slot_index, bool handle_shortage = true) {
+        auto header_size = header.ByteSizeLong();
+        auto message_size = message.ByteSizeLong();
+        if (header_size > max_message_length || message_size > max_message_length) {
+            return false;
+        }
+        auto length = delimited_size(header_size) + delimited_size(message_size);
+        if (length > max_message_length) {
+            return false;
+        }
+        slot_index = handle_shortage ? acquire_slot() : wire_.search_slot();
+        wire_.send(length, [&header, &message, header_size, message_size](char* top){
+            auto* ptr = reinterpret_cast<google::protobuf::uint8*>(top);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            ptr = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(static_cast<google::protobuf::uint32>(header_size), ptr);
+            ptr = header.SerializeWithCachedSizesToArray(ptr);
+            ptr = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(static_cast<google::protobuf::uint32>(message_size), ptr);
+            (void) message.SerializeWithCachedSizesToArray(ptr);
+        }, slot_index);
+        return true;
+    }
+
     std::optional<tateyama::proto::endpoint::response::Handshake> handshake() {
         tateyama::proto::endpoint::request::Request request{};
         auto* handshake = request.mutable_handshake();
@@ -677,34 +908,34 @@ private:
     }
 
     std::optional<std::string> receive(tateyama::common::wire::message_header::index_type slot_index) {
-        std::string response_message{};
-        wire_.receive(response_message, slot_index);
-
-        response_header_ = ::tateyama::proto::framework::response::Header{};
-        google::protobuf::io::ArrayInputStream in{response_message.data(), static_cast<int>(response_message.length())};
-        if(auto res = tateyama::utils::ParseDelimitedFromZeroCopyStream(std::addressof(response_header_), std::addressof(in), nullptr); ! res) {
-            return std::nullopt;
-        }
-        if (response_header_.payload_type() == ::tateyama::proto::framework::response::Header_PayloadType::Header_PayloadType_SERVER_DIAGNOSTICS) {
-            std::string_view record{};
-            if (auto res = tateyama::utils::GetDelimitedBodyFromZeroCopyStream(std::addressof(in), nullptr, record); ! res) {
-                return std::nullopt;
-            }
-            if(auto res = framework_error_.ParseFromArray(record.data(), static_cast<int>(record.length())); ! res) {
-                return std::nullopt;
+        std::optional<std::string> response_opt{};
+        bool diagnostics{};
+        bool unknown{};
+        wire_.receive([this, &response_opt, &diagnostics, &unknown](std::string_view response_message){
+            std::string_view payload{};
+            switch (parse_response_header(response_message, payload)) {
+            case payload_status::service_result:
+                response_opt = std::string{payload};
+                return;
+            case payload_status::server_diagnostics:
+                diagnostics = true;
+                return;
+            case payload_status::unknown:
+                unknown = true;
+                return;
+            case payload_status::error:
+                return;
             }
+        }, slot_index);
+
+        if (diagnostics) {
             using std::string_literals::operator""s; // NOLINT(*-unused-using-decls)
             throw std::runtime_error("received SERVER_DIAGNOSTICS("s + std::to_string(framework_error_.code()) + "), " + framework_error_.message());
         }
-        if (response_header_.payload_type() != ::tateyama::proto::framework::response::Header_PayloadType::Header_PayloadType_SERVICE_RESULT) {
+        if (unknown) {
             throw std::runtime_error("unknown payload type");
         }
-        std::string_view response{};
-        bool eof{};
-        if(auto res = tateyama::utils::GetDelimitedBodyFromZeroCopyStream(std::addressof(in), &eof, response); ! res) {
-            return std::nullopt;
-        }
-        return std::string{response};
+        return response_opt;
     }
 };
 
@@ -17,18 +17,107 @@
 
 #include <atomic>
 #include <array>
+#include <vector>
+#include <optional>
+#include <chrono>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 #include <stdexcept> // std::runtime_error
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "wire.h"
 
 namespace tateyama::common::wire {
 
+/**
+ * @brief the policy of the request slot table.
+ */
+struct slot_policy {
+    static constexpr std::size_t default_count = 16;
+    static constexpr std::size_t max_count = message_header::terminate_request;
+
+    std::size_t count{default_count};       // the number of slots
+    bool blocking{false};                   // wait for a free slot instead of throwing when all slots are in use
+    std::chrono::milliseconds timeout{0};   // the limit of the wait for a free slot, 0 means no limit
+};
+
+/**
+ * @brief counters of the space of result set records returned to the server, local to the client
+ */
+struct release_statistics {
+    std::uint64_t releases{};       // the number of times the space has been returned
+    std::uint64_t records{};        // the number of records whose space has been returned
+    std::uint64_t bytes{};          // the size of the space returned, including the record headers
+    std::uint64_t writer_stalls{};  // the releases made while the server has been waiting for the space
+};
+
+/**
+ * @brief a buffer in the shared memory object mapped twice back to back, read only,
+ *  so that a chunk wrapping around the end of the ring buffer can be read contiguously.
+ */
+class mirrored_mapping {
+public:
+    mirrored_mapping(int fd, std::size_t offset, std::size_t capacity) : capacity_(capacity) {
+        void* area = mmap(nullptr, capacity_ * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);  // NOLINT
+        if (area == MAP_FAILED) {  // NOLINT
+            throw std::runtime_error("cannot reserve the address space for the mirrored buffer");
+        }
+        auto* base = static_cast<char*>(area);
+        for (std::size_t i = 0; i < 2; i++) {
+            if (mmap(base + capacity_ * i, capacity_, PROT_READ, MAP_SHARED | MAP_FIXED, fd, static_cast<off_t>(offset)) == MAP_FAILED) {  // NOLINT
+                munmap(area, capacity_ * 2);
+                throw std::runtime_error("cannot map the mirrored buffer");
+            }
+        }
+        base_ = base;
+    }
+    ~mirrored_mapping() {
+        munmap(base_, capacity_ * 2);
+    }
+
+    mirrored_mapping(mirrored_mapping const&) = delete;
+    mirrored_mapping(mirrored_mapping&&) = delete;
+    mirrored_mapping& operator = (mirrored_mapping const&) = delete;
+    mirrored_mapping& operator = (mirrored_mapping&&) = delete;
+
+    /**
+     * @brief check the buffer can be mirrored, which requires page granularity.
+     */
+    static bool mappable(std::size_t offset, std::size_t capacity) {
+        auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return capacity > 0 && (offset % page_size) == 0 && (capacity % page_size) == 0;
+    }
+    [[nodiscard]] const char* base() const noexcept {
+        return base_;
+    }
+
+private:
+    char* base_{};
+    std::size_t capacity_;
+};
+
+/**
+ * @brief the way responses are received from the response wire.
+ */
+enum class receive_mode {
+    /**
+     * @brief the thread winning the election reads the response wire for all the waiting threads.
+     */
+    leader_election,
+    /**
+     * @brief a dedicated thread reads the response wire and wakes the thread waiting for each slot.
+     */
+    dispatcher,
+};
+
 class session_wire_container
 {
     static constexpr std::size_t metadata_size_boundary = 256;
-    static constexpr std::size_t slot_size = 16;
+    static constexpr std::size_t slot_word_bits = 64;
+    static constexpr std::size_t scratch_initial_capacity = 4096;  // for messages wrapping around the ring buffer
     constexpr static tateyama::common::wire::response_header::msg_type RESPONSE_BODYHEAD = 2;
 
 public:
@@ -52,12 +141,22 @@ public:
                     if (!wrap_around_.empty()) {
                         wrap_around_.clear();
                     }
+                    if (current_wire_ != nullptr && !current_wire_->has_record(unreleased_, known_valid_)) {
+                        release();
+                        current_wire_ = nullptr;
+                        current_mirror_ = nullptr;
+                    }
                     if (current_wire_ == nullptr) {
                         current_wire_ = active_wire();
+                        known_valid_ = 0;
+                        current_mirror_ = (current_wire_ != nullptr && envelope_->resultset_mirroring_) ? mirror_of(current_wire_) : nullptr;
+                    }
+                    if (current_mirror_ != nullptr) {
+                        return current_wire_->get_chunk_mirrored(current_mirror_, unreleased_);
                     }
                     if (current_wire_ != nullptr) {
                         std::string_view extrusion{};
-                        auto rtnv = current_wire_->get_chunk(current_wire_->get_bip_address(managed_shm_ptr_), extrusion);
+                        auto rtnv = current_wire_->get_chunk(current_wire_->get_bip_address(managed_shm_ptr_), extrusion, unreleased_);
                         if (extrusion.empty()) {
                             return rtnv;
                         }
@@ -75,25 +174,51 @@ public:
                 }
             }
         }
+        /**
+         * @brief dispose of the current record, whose space is returned to the server
+         *  when the records disposed of reach the release batch, or when the server is waiting for the space.
+         */
         void dispose() {
             if (current_wire_ != nullptr) {
-                current_wire_->dispose(current_wire_->get_bip_address(managed_shm_ptr_));
-                current_wire_ = nullptr;
-                return;
+                unreleased_ += current_wire_->chunk_size();
+                unreleased_records_++;
+                if (unreleased_records_ >= release_records_ ||
+                    (release_bytes_ > 0 && unreleased_ >= release_bytes_) ||
+                    unreleased_ * 2 >= current_wire_->get_capacity() ||
+                    current_wire_->writer_waiting()) {
+                    release();
+                }
             }
         }
         bool is_eor() noexcept {
             return shm_resultset_wires_->is_eor();
         }
         void set_closed() {
+            if (current_wire_ != nullptr) {
+                release();
+                current_wire_ = nullptr;
+                current_mirror_ = nullptr;
+            }
             shm_resultset_wires_->set_closed();
         }
+        /**
+         * @brief set the release batch.
+         * @param records the number of records disposed of before their space is returned, 1 or greater
+         * @param bytes the size of records disposed of before their space is returned, 0 means no limit by size
+         */
+        void set_release_batch(std::size_t records, std::size_t bytes) noexcept {
+            release_records_ = records;
+            release_bytes_ = bytes;
+        }
+        [[nodiscard]] const release_statistics& get_release_statistics() const noexcept {
+            return release_statistics_;
+        }
         session_wire_container* get_envelope() noexcept {
             return envelope_;
         }
 
         shm_resultset_wire* active_wire() {
-            return shm_resultset_wires_->active_wire();
+            return shm_resultset_wires_->active_wire(0, envelope_->wait_strategy_, &envelope_->wait_statistics_);
         }
 
     private:
@@ -104,18 +229,86 @@ public:
         //   for client
         shm_resultset_wire* current_wire_{};
         std::string wrap_around_{};
+        const char* current_mirror_{};
+        std::size_t known_valid_{};         // the position up to which the server is known to have written the current wire
+        std::size_t unreleased_{};          // the size of the records disposed of but not yet returned
+        std::size_t unreleased_records_{};
+        std::size_t release_records_{1};
+        std::size_t release_bytes_{};
+        release_statistics release_statistics_{};
+        std::vector<std::pair<boost::interprocess::managed_shared_memory::handle_t, std::unique_ptr<mirrored_mapping>>> mirrors_{};
+
+        // return the space of the records disposed of to the server
+        void release() {
+            if (unreleased_ > 0) {
+                if (current_wire_->release(unreleased_)) {
+                    release_statistics_.writer_stalls++;
+                }
+                release_statistics_.releases++;
+                release_statistics_.records += unreleased_records_;
+                release_statistics_.bytes += unreleased_;
+                unreleased_ = 0;
+                unreleased_records_ = 0;
+            }
+        }
+
+        /**
+         * @brief provide the mirrored buffer of the wire, mapping it on first use.
+         * @return the address of the mirrored buffer, nullptr if the buffer cannot be mirrored
+         */
+        const char* mirror_of(shm_resultset_wire* wire) {
+            auto handle = wire->get_handle();
+            for (auto&& e : mirrors_) {
+                if (e.first == handle) {
+                    return e.second ? e.second->base() : nullptr;
+                }
+            }
+            // the handle is the offset from the top of the shared memory object
+            auto offset = static_cast<std::size_t>(handle);
+            std::unique_ptr<mirrored_mapping> mapping{};
+            if (mirrored_mapping::mappable(offset, wire->get_capacity())) {
+                std::string shm_name = (envelope_->db_name_.front() == '/') ? envelope_->db_name_ : ("/" + envelope_->db_name_);
+                if (int fd = shm_open(shm_name.c_str(), O_RDONLY, 0); fd >= 0) {
+                    try {
+                        mapping = std::make_unique<mirrored_mapping>(fd, offset, wire->get_capacity());
+                    } catch (std::runtime_error &ex) {
+                        std::cerr << ex.what() << std::endl;
+                    }
+                    ::close(fd);
+                }
+            }
+            const char* base = mapping ? mapping->base() : nullptr;
+            mirrors_.emplace_back(handle, std::move(mapping));
+            return base;
+        }
     };
 
     class request_wire_container {
     public:
         request_wire_container() = default;
-        request_wire_container(unidirectional_message_wire* wire, char* bip_buffer) noexcept : wire_(wire), bip_buffer_(bip_buffer) {};
+        request_wire_container(unidirectional_message_wire* wire, char* bip_buffer) : wire_(wire), bip_buffer_(bip_buffer) {
+            scratch_.reserve(scratch_initial_capacity);
+        };
         message_header peep() {
             return wire_->peep(bip_buffer_);
         }
+        [[nodiscard]] std::size_t get_capacity() const noexcept {
+            return wire_->get_capacity();
+        }
         void write(const std::string& data, message_header::index_type index) {
             wire_->write(bip_buffer_, data.data(), message_header(index, data.length()));
         }
+        template <typename F>
+        void write(std::size_t length, F&& writer, message_header::index_type index) {
+            if (auto* top = wire_->reserve(bip_buffer_, length, known_poped_); top != nullptr) {
+                writer(top);
+                wire_->commit(bip_buffer_, message_header(index, length));
+                return;
+            }
+            scratch_.resize(length);  // in case of ring buffer wrap around
+            writer(scratch_.data());
+            wire_->write(bip_buffer_, scratch_.data(), message_header(index, length));
+        }
         void disconnect() {
             wire_->terminate();
         }
@@ -123,13 +316,17 @@ public:
     private:
         unidirectional_message_wire* wire_{};
         char* bip_buffer_{};
+        std::string scratch_{};
+        std::size_t known_poped_{};  // the read position of the server last loaded, written only under the request wire lock
     };
 
     class response_wire_container {
     public:
         response_wire_container() = default;
-        response_wire_container(session_wire_container* envelope, unidirectional_response_wire* wire, char* bip_buffer) noexcept
-            : envelope_(envelope), wire_(wire), bip_buffer_(bip_buffer) {};
+        response_wire_container(session_wire_container* envelope, unidirectional_response_wire* wire, char* bip_buffer)
+            : envelope_(envelope), wire_(wire), bip_buffer_(bip_buffer) {
+            scratch_.reserve(scratch_initial_capacity);
+        };
         [[nodiscard]] response_header::length_type get_length() const noexcept {
             return wire_->get_length();
         }
@@ -142,6 +339,18 @@ public:
         void read(char* top) {
             wire_->read(top, bip_buffer_);
         }
+        template <typename F>
+        void consume(F&& consumer) {
+            std::string_view view{};
+            if (wire_->payload_in_place(bip_buffer_, view)) {
+                consumer(view);
+                wire_->dispose_payload();
+                return;
+            }
+            scratch_.resize(wire_->get_length());  // in case of ring buffer wrap around
+            wire_->read(scratch_.data(), bip_buffer_);
+            consumer(std::string_view(scratch_));
+        }
         void close() {
             wire_->close();
         }
@@ -150,11 +359,12 @@ public:
         session_wire_container* envelope_{};
         unidirectional_response_wire* wire_{};
         char* bip_buffer_{};
+        std::string scratch_{};
 
         response_header await() {
             while (true) {
                 try {
-                    return wire_->await(bip_buffer_);
+                    return wire_->await(bip_buffer_, 0, envelope_->wait_strategy_, &envelope_->wait_statistics_);
                 } catch (std::runtime_error &ex) {
                     if (auto err = envelope_->get_status_provider().is_alive(); !err.empty()) {
                         throw ex;  // FIXME handle this
@@ -171,9 +381,6 @@ public:
     public:
         slot() = default;
 
-        bool test_and_set_in_use() {
-            return in_use_.test_and_set();
-        }
         bool valid() {
             return received_.load() > consumed_.load();
         }
@@ -190,35 +397,64 @@ public:
             std::atomic_thread_fence(std::memory_order_acq_rel);
             received_++;
         }
-        void receive_and_consume(response_header::msg_type msg_type) {
+        // used in the dispatcher mode
+        void post_receive_and_notify() {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                post_receive();
+            }
+            cnd_.notify_one();
+        }
+        void notify() {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+            }
+            cnd_.notify_one();
+        }
+        template <typename P>
+        void wait(P&& ready) {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cnd_.wait(lock, std::forward<P>(ready));
+        }
+        /**
+         * @return true if the slot has received all the responses of the request
+         */
+        bool receive_and_consume(response_header::msg_type msg_type) {
             if (expected_ == 0) {
                 expected_ = (msg_type == RESPONSE_BODYHEAD) ? 2 : 1;
             }
             if (expected_ == 2 && received_.load() == 0) {
                 received_++;
                 consumed_++;
-            } else {
-                finish_receive();
+                return false;
             }
+            finish_receive();
+            return true;
         }
-        void consume(std::string& message) {
+        /**
+         * @return true if the slot has consumed all the responses of the request
+         */
+        template <typename F>
+        bool consume(F&& consumer) {
             if (expected_ == 2 && consumed_.load() == 0) {
-                message = body_head_message_;
+                consumer(std::string_view(body_head_message_));
                 std::atomic_thread_fence(std::memory_order_acq_rel);
                 consumed_++;
-            } else {
-                message = body_message_;
-                finish_receive();
+                return false;
             }
+            consumer(std::string_view(body_message_));
+            finish_receive();
+            return true;
         }
 
     private:
-        std::atomic_flag in_use_{};
         std::atomic_int received_{};
         std::atomic_int consumed_{};
         std::int32_t expected_{};
         std::string body_message_{};
         std::string body_head_message_{};
+        std::mutex mtx_{};
+        std::condition_variable cnd_{};
 
         void finish_receive() {
             body_message_.clear();
@@ -227,11 +463,19 @@ public:
             consumed_.store(0);
             expected_ = 0;
             std::atomic_thread_fence(std::memory_order_acq_rel);
-            in_use_.clear();
         }
     };
 
-    explicit session_wire_container(std::string_view name) : db_name_(name) {
+    explicit session_wire_container(std::string_view name, const wait_strategy& strategy = {}, const slot_policy& policy = {}, receive_mode mode = receive_mode::leader_election)
+        : db_name_(name), slot_policy_(policy), wait_strategy_(strategy) {
+        if (slot_policy_.count == 0 || slot_policy_.count > slot_policy::max_count) {
+            throw std::runtime_error("invalid number of slots");
+        }
+        slot_status_ = std::vector<slot>(slot_policy_.count);
+        slot_in_use_ = std::vector<std::atomic_uint64_t>((slot_policy_.count + slot_word_bits - 1) / slot_word_bits);
+        if (auto tail = slot_policy_.count % slot_word_bits; tail != 0) {
+            slot_in_use_.back().store(~((1ULL << tail) - 1));  // the bits beyond the slot count are never free
+        }
         try {
             managed_shared_memory_ = std::make_unique<boost::interprocess::managed_shared_memory>(boost::interprocess::open_only, db_name_.c_str());
             auto req_wire = managed_shared_memory_->find<unidirectional_message_wire>(request_wire_name).first;
@@ -246,9 +490,17 @@ public:
         catch(const boost::interprocess::interprocess_exception& ex) {
             throw std::runtime_error("cannot find a session with the specified name");
         }
+        if (mode == receive_mode::dispatcher) {
+            dispatcher_ = std::thread([this]{ dispatch(); });
+        }
     }
 
-    ~session_wire_container() = default;
+    ~session_wire_container() {
+        if (dispatcher_.joinable()) {
+            response_wire_.close();  // wakes the dispatcher
+            dispatcher_.join();
+        }
+    }
 
     void close() {
         request_wire_.disconnect();
@@ -268,28 +520,98 @@ public:
     }
 
     // handle request and response
+    /**
+     * @brief acquire a free slot, waiting for one to be released if the slot policy is blocking.
+     * @return the index of the slot acquired
+     * @throws std::runtime_error if no slot is available
+     */
     message_header::index_type search_slot() {
-        for(message_header::index_type i = 0; i < slot_size; i++) {
-            if (!slot_status_.at(i).test_and_set_in_use()) {
-                return i;
-            }
+        if (auto index = try_acquire_slot(); index) {
+            return index.value();
+        }
+        if (!slot_policy_.blocking) {
+            throw std::runtime_error("running out of slot");
         }
-        throw std::runtime_error("running out of slot");
+        std::optional<message_header::index_type> index{};
+        auto acquired = [this, &index]{ index = try_acquire_slot(); return index.has_value(); };
+        std::unique_lock<std::mutex> lock(mtx_slot_);
+        slot_waiters_++;
+        if (slot_policy_.timeout.count() == 0) {
+            cnd_slot_.wait(lock, acquired);
+        } else {
+            (void) cnd_slot_.wait_for(lock, slot_policy_.timeout, acquired);
+        }
+        slot_waiters_--;
+        if (!index) {
+            throw std::runtime_error("timeout in waiting for a free slot");
+        }
+        return index.value();
+    }
+    /**
+     * @brief acquire a free slot without waiting.
+     * @return the index of the slot acquired, std::nullopt if no slot is free
+     */
+    std::optional<message_header::index_type> try_search_slot() {
+        return try_acquire_slot();
+    }
+    [[nodiscard]] std::size_t slot_count() const noexcept {
+        return slot_policy_.count;
+    }
+    /**
+     * @brief get the maximum length of a request message that fits in the request wire at once.
+     */
+    [[nodiscard]] std::size_t max_request_length() const noexcept {
+        return request_wire_.get_capacity() - message_header::size;
     }
     void send(const std::string& req_message, message_header::index_type slot_index) {
         std::unique_lock<std::mutex> lock(mtx_send_);
         request_wire_.write(req_message, slot_index);
     }
-    void receive(std::string& res_message, message_header::index_type slot_index) {
+    /**
+     * @brief send a request message by letting the writer fill it in the request wire directly.
+     * @param length the length of the request message
+     * @param writer the function taking char* to write exactly length bytes
+     * @param slot_index the slot index of the request
+     */
+    template <typename F>
+    void send(std::size_t length, F&& writer, message_header::index_type slot_index) {
+        std::unique_lock<std::mutex> lock(mtx_send_);
+        request_wire_.write(length, std::forward<F>(writer), slot_index);
+    }
+    /**
+     * @brief receive the response message for the slot and pass its view to the consumer.
+     *  The view refers to the response wire directly unless the message wraps around the ring buffer,
+     *  and the space is released after the consumer returns.
+     * @param consumer the function taking std::string_view, which must not throw
+     * @param slot_index the slot index of the request
+     */
+    template <typename F>
+    void receive(F&& consumer, message_header::index_type slot_index) {
         slot& my_slot = slot_status_.at(static_cast<std::size_t>(slot_index));
 
+        if (dispatcher_.joinable()) {
+            auto ready = [this, &my_slot]{ return my_slot.valid() || dispatcher_failed_.load(); };
+            if (!ready() && !spin_and_yield(wait_strategy_, nullptr, ready)) {
+                my_slot.wait(ready);
+            }
+            if (!my_slot.valid()) {
+                throw std::runtime_error(dispatcher_error_);
+            }
+            if (my_slot.consume(consumer)) {
+                release_slot(slot_index);
+            }
+            return;
+        }
+
         while (true) {
             {
                 std::unique_lock<std::mutex> lock(mtx_receive_);
                 cnd_receive_.wait(lock, [this, slot_index]{ return slot_status_.at(static_cast<std::size_t>(slot_index)).valid() || !using_wire_.load(); });
             }
             if (my_slot.valid()) {
-                my_slot.consume(res_message);
+                if (my_slot.consume(consumer)) {
+                    release_slot(slot_index);
+                }
                 cnd_receive_.notify_all();
                 return;
             }
@@ -302,14 +624,15 @@ public:
                 auto header_received = response_wire_.await();
                 auto index_received = header_received.get_idx();
                 if (index_received == slot_index) {
-                    res_message.resize(header_received.get_length());
-                    response_wire_.read(res_message.data());
-                    my_slot.receive_and_consume(header_received.get_type());
+                    response_wire_.consume(consumer);
+                    if (my_slot.receive_and_consume(header_received.get_type())) {
+                        release_slot(slot_index);
+                    }
                     using_wire_.store(false);
                     cnd_receive_.notify_all();
                     return;
                 }
-                auto& slot_received = slot_status_.at(static_cast<std::size_t>(index_received));
+                auto& slot_received = slot_status_.at(static_cast<std::size_t>(index_received));  // throws if the index is broken
                 std::string& message_received = slot_received.pre_receive(header_received.get_type());
                 message_received.resize(header_received.get_length());
                 response_wire_.read(message_received.data());
@@ -337,17 +660,118 @@ public:
         return *status_provider_;
     }
 
+    // no slot is in use, so that no response is left to be received
+    [[nodiscard]] bool is_idle() const noexcept {
+        for (std::size_t w = 0; w < slot_in_use_.size(); w++) {
+            std::uint64_t unused{};
+            if (auto tail = slot_policy_.count % slot_word_bits; tail != 0 && w == slot_in_use_.size() - 1) {
+                unused = ~((1ULL << tail) - 1);
+            }
+            if (slot_in_use_.at(w).load(std::memory_order_acquire) != unused) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // waiting strategy for the response and the result set
+    void set_wait_strategy(const wait_strategy& strategy) noexcept {
+        wait_strategy_ = strategy;
+    }
+    [[nodiscard]] const wait_strategy& get_wait_strategy() const noexcept {
+        return wait_strategy_;
+    }
+    [[nodiscard]] const wait_statistics& get_wait_statistics() const noexcept {
+        return wait_statistics_;
+    }
+
+    // read result sets through the buffers mapped twice back to back, where they can be
+    void set_resultset_mirroring(bool mirroring) noexcept {
+        resultset_mirroring_ = mirroring;
+    }
+
 private:
     std::string db_name_;
     std::unique_ptr<boost::interprocess::managed_shared_memory> managed_shared_memory_{};
     request_wire_container request_wire_{};
     response_wire_container response_wire_{};
     status_provider* status_provider_{};
-    std::array<slot, slot_size> slot_status_{};
+    slot_policy slot_policy_;
+    std::vector<slot> slot_status_{};
+    std::vector<std::atomic_uint64_t> slot_in_use_{};  // bitmap of the slots in use
+    std::mutex mtx_slot_{};
+    std::condition_variable cnd_slot_{};
+    std::size_t slot_waiters_{};  // guarded by mtx_slot_
     std::mutex mtx_send_{};
     std::mutex mtx_receive_{};
     std::condition_variable cnd_receive_{};
     std::atomic_bool using_wire_{};
+    wait_strategy wait_strategy_;
+    wait_statistics wait_statistics_{};
+    bool resultset_mirroring_{};
+    std::thread dispatcher_{};
+    std::atomic_bool dispatcher_failed_{};
+    std::string dispatcher_error_{};  // set before dispatcher_failed_
+
+    /**
+     * @brief read the response wire and hand each response to its slot, used in the dispatcher mode.
+     */
+    void dispatch() {
+        while (true) {
+            response_header header{};
+            try {
+                header = response_wire_.await();
+            } catch (std::runtime_error& ex) {
+                fail_dispatch(ex.what());
+                return;
+            }
+            if (header.get_type() == 0) {
+                fail_dispatch("the session has been closed");
+                return;
+            }
+            auto index = static_cast<std::size_t>(header.get_idx());
+            if (index >= slot_status_.size()) {
+                fail_dispatch("the response has an invalid slot index");
+                return;
+            }
+            auto& slot_received = slot_status_.at(index);
+            std::string& message_received = slot_received.pre_receive(header.get_type());
+            message_received.resize(header.get_length());
+            response_wire_.read(message_received.data());
+            slot_received.post_receive_and_notify();
+        }
+    }
+    void fail_dispatch(std::string_view reason) {
+        dispatcher_error_ = reason;
+        dispatcher_failed_.store(true);
+        for (auto& s : slot_status_) {
+            s.notify();
+        }
+    }
+
+    std::optional<message_header::index_type> try_acquire_slot() {
+        for (std::size_t w = 0; w < slot_in_use_.size(); w++) {
+            auto& word = slot_in_use_.at(w);
+            auto bits = word.load(std::memory_order_relaxed);
+            while (~bits != 0) {
+                auto bit = static_cast<std::size_t>(__builtin_ctzll(~bits));
+                if (word.compare_exchange_weak(bits, bits | (1ULL << bit), std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return static_cast<message_header::index_type>(w * slot_word_bits + bit);
+                }
+            }
+        }
+        return std::nullopt;
+    }
+    void release_slot(message_header::index_type index) {
+        auto i = static_cast<std::size_t>(index);
+        slot_in_use_.at(i / slot_word_bits).fetch_and(~(1ULL << (i % slot_word_bits)), std::memory_order_release);
+        if (slot_policy_.blocking) {
+            std::unique_lock<std::mutex> lock(mtx_slot_);
+            if (slot_waiters_ > 0) {
+                cnd_slot_.notify_one();
+            }
+        }
+    }
 
     void dispose_resultset_wire(std::unique_ptr<resultset_wires_container>& container) {
         container->set_closed();
@@ -23,8 +23,10 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <cstdint>
 #include <sys/file.h>
+#include <unistd.h>
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/interprocess/sync/interprocess_condition.hpp>
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
@@ -179,7 +181,7 @@ public:
      */
     std::string_view payload(const char* base) {
         auto length = static_cast<std::size_t>(header_received_.get_length());
-        if (index(poped_.load() + T::size) < index(poped_.load() + T::size + length)) {
+        if (length <= max_payload_length() && index(poped_.load() + T::size) < index(poped_.load() + T::size + length)) {
             need_dispose_ = T::size + length;
             return std::string_view(read_address(base, T::size), length);
         }
@@ -323,13 +325,13 @@ protected:
         }
     }
 
-    void copy_header(const char* base) {
-        if ((base + capacity_) >= (read_address(base) + T::size)) {  //NOLINT
-            header_received_ = T(read_address(base));  // normal case
+    void copy_header(const char* base, std::size_t offset = 0) {
+        if ((base + capacity_) >= (read_address(base, offset) + T::size)) {  //NOLINT
+            header_received_ = T(read_address(base, offset));  // normal case
         } else {
             char buf[T::size];  // in case for ring buffer full  //NOLINT
-            std::size_t first_part = capacity_ - index(poped_.load());
-            memcpy(buf, read_address(base), first_part);  //NOLINT
+            std::size_t first_part = capacity_ - index(poped_.load() + offset);
+            memcpy(buf, read_address(base, offset), first_part);  //NOLINT
             memcpy(buf + first_part, base, T::size - first_part);  //NOLINT
             header_received_ = T(static_cast<char*>(buf));
         }
@@ -369,12 +371,72 @@ inline static std::int64_t n_cap(std::int64_t timeout) {
     return (timeout > (MAX_TIMEOUT * 1000)) ? (MAX_TIMEOUT * 1000) : timeout;
 }
 
+/**
+ * @brief the strategy of the reader waiting for data arrival in a wire,
+ *  it spins spin_count times, then yields yield_count times, and then blocks on the condition.
+ *  this is a setting local to the reader process and is not placed in the shared memory.
+ */
+struct wait_strategy {
+    std::uint32_t spin_count{};
+    std::uint32_t yield_count{};
+};
+
+/**
+ * @brief counters telling which phase of the wait_strategy has resolved each wait,
+ *  local to the reader process
+ */
+struct wait_statistics {
+    std::atomic_ullong immediate{};
+    std::atomic_ullong spin{};
+    std::atomic_ullong yield{};
+    std::atomic_ullong block{};
+};
+
+inline static void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");  // NOLINT
+#endif
+}
+
+/**
+ * @brief wait for the condition without blocking, according to the wait_strategy.
+ * @return true if the condition has been satisfied in the spin or yield phase
+ */
+template <typename F>
+inline static bool spin_and_yield(const wait_strategy& strategy, wait_statistics* statistics, F&& ready) {
+    for (std::uint32_t i = 0; i < strategy.spin_count; i++) {
+        cpu_relax();
+        if (ready()) {
+            if (statistics != nullptr) {
+                statistics->spin++;
+            }
+            return true;
+        }
+    }
+    for (std::uint32_t i = 0; i < strategy.yield_count; i++) {
+        std::this_thread::yield();
+        if (ready()) {
+            if (statistics != nullptr) {
+                statistics->yield++;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
 // for request
 class unidirectional_message_wire : public simple_wire<message_header> {
     constexpr static std::size_t watch_interval = 2;
 public:
     unidirectional_message_wire(boost::interprocess::managed_shared_memory* managed_shm_ptr, std::size_t capacity) : simple_wire<message_header>(managed_shm_ptr, capacity) {}
 
+    [[nodiscard]] std::size_t get_capacity() const noexcept {
+        return capacity_;
+    }
+
     /**
      * @brief wait a request message arives and peep the current header.
      * @return the essage_header if request message has been received, for normal reception of request message.
@@ -441,6 +503,50 @@ public:
     void write(char* base, const char* from, message_header header) {
         simple_wire<message_header>::write(base, from, header, closed_);
     }
+    /**
+     * @brief reserve the room for a request message in the request wire, used by the client.
+     *  The caller writes the payload at the address returned and then calls commit(),
+     *  no other message can be written between them.
+     *  The position read by the server is loaded only when the one known so far does not leave enough room,
+     *  or is capacity or more behind the written position, as it can be after a message written by write().
+     * @param base the base address of the request wire
+     * @param length the length of the payload
+     * @param known_poped the position up to which the server is known to have read, updated when loaded
+     * @return the address where the payload is to be written,
+     *  nullptr if the payload cannot be placed contiguously or the wire has been closed
+     */
+    char* reserve(char* base, std::size_t length, std::size_t& known_poped) {
+        std::size_t msg_length = length + message_header::size;
+        if (msg_length > capacity_) {
+            return nullptr;
+        }
+        if (auto used = pushed_.load() - known_poped; used >= capacity_ || msg_length > capacity_ - used) {
+            if (msg_length > room() && !closed_.load()) { wait_to_write(msg_length, closed_); }
+            known_poped = poped_.load();
+        }
+        if (closed_.load()) {
+            return nullptr;
+        }
+        auto top = pushed_.load() + message_header::size;
+        if (index(top) + length > capacity_) {
+            return nullptr;  // ring buffer wrap around case
+        }
+        return buffer_address(base, top);
+    }
+    /**
+     * @brief write the header of the reserved request message and make it visible to the server.
+     * @param base the base address of the request wire
+     * @param header the header of the request message, whose length must be the one given to reserve()
+     */
+    void commit(char* base, message_header header) {
+        write_in_buffer(base, buffer_address(base, pushed_.load()), header.get_buffer(), message_header::size);
+        pushed_.fetch_add(message_header::size + header.get_length());
+        std::atomic_thread_fence(std::memory_order_acq_rel);
+        if (wait_for_read_) {
+            boost::interprocess::scoped_lock lock(m_mutex_);
+            c_empty_.notify_one();
+        }
+    }
     /**
      * @brief wake up the worker thread waiting for request arrival, supposed to be used in server termination.
      */
@@ -469,22 +575,36 @@ public:
 
     /**
      * @brief wait for response arrival and return its header.
+     * @param base the base address of the response wire
+     * @param timeout the timeout of the blocking phase in microseconds, 0 means watch_interval
+     * @param strategy the strategy applied before blocking
+     * @param statistics the counters to be updated, can be nullptr
      */
-    response_header await(const char* base, std::int64_t timeout = 0) {
+    response_header await(const char* base, std::int64_t timeout = 0, const wait_strategy& strategy = {}, wait_statistics* statistics = nullptr) {
         if (timeout == 0) {
             timeout = watch_interval * 1000 * 1000;
         }
 
+        bool first = true;
         while (true) {
             bool closed_shutdown = closed_.load() || shutdown_.load();
             std::atomic_thread_fence(std::memory_order_acq_rel);
             if(stored() >= response_header::size) {
+                if (first && statistics != nullptr) {
+                    statistics->immediate++;
+                }
                 break;
             }
             if (closed_shutdown) {
                 header_received_ = response_header(0, 0, 0);
                 return header_received_;
             }
+            if (first) {
+                first = false;
+                if (spin_and_yield(strategy, statistics, [this](){ return (stored() >= response_header::size) || closed_.load() || shutdown_.load(); })) {
+                    continue;
+                }
+            }
             {
                 boost::interprocess::scoped_lock lock(m_mutex_);
                 wait_for_read_ = true;
@@ -495,6 +615,9 @@ public:
                     throw std::runtime_error("response has not been received within the specified time");
                 }
                 wait_for_read_ = false;
+                if (statistics != nullptr) {
+                    statistics->block++;
+                }
             }
         }
 
@@ -509,6 +632,36 @@ public:
         }
         return header_received_;
     }
+    /**
+     * @brief provide the view of the payload of the current response message if it is placed contiguously
+     *  in the response wire, in which case the space is to be released by dispose_payload() after use.
+     * @param base the base address of the response wire
+     * @param view returns the view of the payload
+     * @return true if the payload is placed contiguously
+     */
+    [[nodiscard]] bool payload_in_place(const char* base, std::string_view& view) const {
+        std::size_t length = header_received_.get_length();
+        if (length > max_payload_length()) {
+            return false;
+        }
+        auto top = index(poped_.load() + response_header::size);
+        if (top + length > capacity_) {
+            return false;  // ring buffer wrap around case
+        }
+        view = std::string_view(base + top, length);  // NOLINT
+        return true;
+    }
+    /**
+     * @brief release the space of the current response message whose payload has been used in place.
+     */
+    void dispose_payload() {
+        poped_.fetch_add(response_header::size + header_received_.get_length());
+        std::atomic_thread_fence(std::memory_order_acq_rel);
+        if (wait_for_write_) {
+            boost::interprocess::scoped_lock lock(m_mutex_);
+            c_full_.notify_one();
+        }
+    }
     [[nodiscard]] response_header::length_type get_length() const {
         return header_received_.get_length();
     }
@@ -639,19 +792,20 @@ public:
         /**
          * @brief provide the current chunk.
          *  used by clinet
+         * @param offset the size of the chunks read but not yet disposed of, which precede the current chunk
          */
-        std::string_view get_chunk(char* base, std::string_view& wrap_around) {
-            copy_header(base);
+        std::string_view get_chunk(char* base, std::string_view& wrap_around, std::size_t offset = 0) {
+            copy_header(base, offset);
             auto length = header_received_.get_length();
+            auto top = poped_.load() + offset + length_header::size;
 
             // If end is on a boundary, it is considered to be on the same page.
-            if (((poped_.load() + length_header::size) / capacity_) == ((poped_.load() + length_header::size + length - 1) / capacity_)) {
-                return {read_address(base, length_header::size), length};
+            if ((top / capacity_) == ((top + length - 1) / capacity_)) {
+                return {read_address(base, offset + length_header::size), length};
             }
-            auto buffer_end = (pushed_valid_.load() / capacity_) * capacity_;
-            std::size_t first_length = buffer_end - (poped_.load() + length_header::size);
-            wrap_around = std::string_view(read_address(base, length_header::size + first_length), length - first_length);
-            return {read_address(base, length_header::size), first_length};
+            std::size_t first_length = ((top / capacity_) + 1) * capacity_ - top;
+            wrap_around = std::string_view(read_address(base, offset + length_header::size + first_length), length - first_length);
+            return {read_address(base, offset + length_header::size), first_length};
         }
         /**
          * @brief dispose of data that has completed read and is no longer needed.
@@ -659,18 +813,73 @@ public:
          */
         void dispose(char* base) {
             copy_header(base);
-            poped_.fetch_add(header_received_.get_length() + length_header::size);
+            release(chunk_size());
+        }
+        /**
+         * @brief provide the current chunk from the buffer mapped twice back to back,
+         *  where every chunk and header is placed contiguously.
+         *  used by clinet
+         * @param mirror the address of the buffer mapped twice
+         * @param offset the size of the chunks read but not yet disposed of, which precede the current chunk
+         */
+        std::string_view get_chunk_mirrored(const char* mirror, std::size_t offset = 0) {
+            header_received_ = length_header(read_address(mirror, offset));
+            return {read_address(mirror, offset + length_header::size), header_received_.get_length()};
+        }
+        /**
+         * @brief the size the chunk provided last takes in the buffer, including its header.
+         *  used by clinet
+         */
+        [[nodiscard]] std::size_t chunk_size() const noexcept {
+            return header_received_.get_length() + length_header::size;
+        }
+        /**
+         * @brief return the space of the chunks that have completed read to the server.
+         *  used by clinet
+         * @param length the total size of the chunks including their headers
+         * @return true if the server has been waiting for the space
+         */
+        bool release(std::size_t length) {
+            poped_.fetch_add(length);
             std::atomic_thread_fence(std::memory_order_acq_rel);
             if (wait_for_write_) {
                 boost::interprocess::scoped_lock lock(m_mutex_);
                 c_full_.notify_one();
+                return true;
             }
+            return false;
+        }
+        /**
+         * @brief check whether the server is waiting for the space to be returned.
+         *  used by clinet
+         */
+        [[nodiscard]] bool writer_waiting() const noexcept {
+            return wait_for_write_;
+        }
+        [[nodiscard]] std::size_t get_capacity() const noexcept {
+            return capacity_;
         }
         /**
          * @brief check this wire has record.
          *  used by clinet
+         * @param offset the size of the chunks read but not yet disposed of
+         */
+        [[nodiscard]] bool has_record(std::size_t offset = 0) const { return stored_valid() > offset; }
+        /**
+         * @brief check this wire has record, loading the position written by the server
+         *  only when the position known so far tells there is no record.
+         *  used by clinet
+         * @param offset the size of the chunks read but not yet disposed of
+         * @param known_valid the position up to which the server is known to have written, updated when loaded
          */
-        [[nodiscard]] bool has_record() const { return stored_valid() > 0; }
+        [[nodiscard]] bool has_record(std::size_t offset, std::size_t& known_valid) const {
+            auto position = poped_.load() + offset;
+            if (position < known_valid) {
+                return true;
+            }
+            known_valid = pushed_valid_.load();
+            return position < known_valid;
+        }
 
         void attach_buffer(boost::interprocess::managed_shared_memory::handle_t handle, std::size_t capacity) noexcept {
             buffer_handle_ = handle;
@@ -751,7 +960,7 @@ public:
      * @brief unidirectional_simple_wires constructer
      */
     unidirectional_simple_wires(boost::interprocess::managed_shared_memory* managed_shm_ptr, std::size_t count, std::size_t buffer_size)
-        : managed_shm_ptr_(managed_shm_ptr), unidirectional_simple_wires_(count, managed_shm_ptr->get_segment_manager()), buffer_size_(buffer_size), reserved_(static_cast<char*>(managed_shm_ptr->allocate_aligned(buffer_size_, Alignment))) {
+        : managed_shm_ptr_(managed_shm_ptr), unidirectional_simple_wires_(count, managed_shm_ptr->get_segment_manager()), buffer_size_(buffer_size), reserved_(static_cast<char*>(managed_shm_ptr->allocate_aligned(buffer_size_, buffer_alignment(buffer_size_)))) {
         for (auto&& wire: unidirectional_simple_wires_) {
             wire.set_environments(this, managed_shm_ptr);
         }
@@ -797,7 +1006,7 @@ public:
             buffer = reserved_;
             reserved_ = nullptr;
         } else {
-            buffer = static_cast<char*>(managed_shm_ptr_->allocate_aligned(buffer_size_, Alignment));
+            buffer = static_cast<char*>(managed_shm_ptr_->allocate_aligned(buffer_size_, buffer_alignment(buffer_size_)));
             if (!buffer) {
                 throw std::runtime_error("cannot allocate shared memory");
             }
@@ -822,18 +1031,40 @@ public:
     /**
      * @brief search a wire that has record sent by the server
      *  used by clinet
+     * @param timeout the timeout of the blocking phase in nanoseconds, 0 means watch_interval
+     * @param strategy the strategy applied before blocking
+     * @param statistics the counters to be updated, can be nullptr
      */
-    unidirectional_simple_wire* active_wire(std::int64_t timeout = 0) {
+    unidirectional_simple_wire* active_wire(std::int64_t timeout = 0, const wait_strategy& strategy = {}, wait_statistics* statistics = nullptr) {
         if (timeout == 0) {
             timeout = watch_interval * 1000 * 1000;
         }
 
+        bool first = true;
         do {  //  NOLINT(cppcoreguidelines-avoid-do-while)
             for (auto&& wire: unidirectional_simple_wires_) {
                 if(wire.has_record()) {
+                    if (first && statistics != nullptr) {
+                        statistics->immediate++;
+                    }
                     return &wire;
                 }
             }
+            if (first) {
+                first = false;
+                if (spin_and_yield(strategy, statistics, [this](){ return has_record() || is_eor(); })) {
+                    bool eor = is_eor();
+                    std::atomic_thread_fence(std::memory_order_acq_rel);
+                    for (auto&& wire: unidirectional_simple_wires_) {
+                        if(wire.has_record()) {
+                            return &wire;
+                        }
+                    }
+                    if (eor) {
+                        return nullptr;
+                    }
+                }
+            }
             {
                 boost::interprocess::scoped_lock lock(m_record_);
                 wait_for_record_ = true;
@@ -860,6 +1091,9 @@ public:
                     throw std::runtime_error("record has not been received within the specified time");
                 }
                 wait_for_record_ = false;
+                if (statistics != nullptr) {
+                    statistics->block++;
+                }
                 if (active_wire != nullptr) {
                     return active_wire;
                 }
@@ -907,6 +1141,14 @@ public:
     }
 
 private:
+    [[nodiscard]] bool has_record() const {
+        for (auto&& wire: unidirectional_simple_wires_) {
+            if (wire.has_record()) {
+                return true;
+            }
+        }
+        return false;
+    }
     std::size_t search_free_wire() noexcept {
         if (count_using_ == next_index_) {
             count_using_++;
@@ -943,6 +1185,12 @@ private:
     static constexpr std::size_t Alignment = 64;
     using allocator = boost::interprocess::allocator<unidirectional_simple_wire, boost::interprocess::managed_shared_memory::segment_manager>;
 
+    // page aligned if possible, so that the client can map the buffer twice back to back
+    static std::size_t buffer_alignment(std::size_t buffer_size) {
+        auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return (buffer_size % page_size == 0) ? page_size : Alignment;
+    }
+
     boost::interprocess::managed_shared_memory* managed_shm_ptr_;  // used by server only
     std::vector<unidirectional_simple_wire, allocator> unidirectional_simple_wires_;
     std::size_t buffer_size_;
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+#include <cstdlib>
+#include <new>
+
+#include "stub_test_root.h"
+
+// counts the heap allocations made by the calling thread
+namespace {
+thread_local std::size_t allocation_count{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* p = std::malloc(size == 0 ? 1 : size); p != nullptr) {  // NOLINT(cppcoreguidelines-no-malloc)
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+void operator delete(void* p) noexcept {
+    std::free(p);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+namespace ogawayama::testing {
+
+static constexpr const char* name_prefix = "allocation_test";
+
+class AllocationTest : public ::testing::Test {
+    void SetUp() override {
+        shm_name_ = std::string(name_prefix);
+        shm_name_ += std::to_string(getpid());
+        server_ = std::make_unique<server>(shm_name_);
+    }
+protected:
+    std::unique_ptr<server> server_{};  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,misc-non-private-member-variables-in-classes)
+    std::string shm_name_{};  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,misc-non-private-member-variables-in-classes)
+};
+
+TEST_F(AllocationTest, execute_statement_steady_state) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::size_t warm_up = 4;
+    static constexpr std::size_t loop = 64;
+
+    StubPtr stub;
+    ConnectionPtr connection;
+    PreparedStatementPtr prepared_statement;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Prepare rp{};
+        auto ps = rp.mutable_prepared_statement_handle();
+        ps->set_handle(1234);
+        ps->set_has_result_records(false);
+        server_->response_message(rp);
+
+        // placeholder names are kept short so that they fit in the small string buffer
+        ogawayama::stub::placeholders_type placeholders{};
+        placeholders.emplace_back("i32", ogawayama::stub::Metadata::ColumnType::Type::INT32);
+        placeholders.emplace_back("i64", ogawayama::stub::Metadata::ColumnType::Type::INT64);
+        placeholders.emplace_back("f64", ogawayama::stub::Metadata::ColumnType::Type::FLOAT64);
+        placeholders.emplace_back("txt", ogawayama::stub::Metadata::ColumnType::Type::TEXT);
+        EXPECT_EQ(ERROR_CODE::OK, connection->prepare("insert into t (c1, c2, c3, c4) values(:i32, :i64, :f64, :txt)", placeholders, prepared_statement));
+    }
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+    }
+
+    {
+        jogasaki::proto::sql::response::ExecuteResult er{};
+        auto* c = er.mutable_success()->add_counters();
+        c->set_type(jogasaki::proto::sql::response::ExecuteResult::INSERTED_ROWS);
+        c->set_value(1);
+        for (std::size_t i = 0; i < warm_up + loop; i++) {
+            server_->response_message(er);
+        }
+    }
+
+    ogawayama::stub::parameters_type parameters{};
+    parameters.emplace_back("i32", static_cast<std::int32_t>(123456));
+    parameters.emplace_back("i64", static_cast<std::int64_t>(123456789));
+    parameters.emplace_back("f64", static_cast<double>(123.456789));
+    parameters.emplace_back("txt", std::string("short"));
+    std::size_t num_rows{};
+
+    for (std::size_t i = 0; i < warm_up; i++) {
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_statement(prepared_statement, parameters, num_rows));
+    }
+
+    std::size_t failures{};
+    auto before = allocation_count;
+    for (std::size_t i = 0; i < loop; i++) {
+        if (transaction->execute_statement(prepared_statement, parameters, num_rows) != ERROR_CODE::OK) {
+            failures++;
+        }
+    }
+    auto allocations = allocation_count - before;
+
+    EXPECT_EQ(0, failures);
+    EXPECT_EQ(1, num_rows);
+    EXPECT_EQ(0, allocations);
+
+    {
+        jogasaki::proto::sql::response::ResultOnly roc{};
+        roc.mutable_success();
+        server_->response_message(roc);
+        server_->response_message(roc);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+}  // namespace ogawayama::testing
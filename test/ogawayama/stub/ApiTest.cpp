@@ -13,11 +13,18 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fcntl.h>
+#include <sys/file.h>
 #include <unistd.h>
+
+#include <optional>
+
 #include <boost/property_tree/ptree.hpp>
 
 #include <jogasaki/serializer/value_output.h>
 
+#include "ogawayama/stub/row_reader.h"
+
 #include "stub_test_root.h"
 
 
@@ -94,6 +101,63 @@ TEST_F(ApiTest, begin_commit) {  // NOLINT(google-readability-avoid-underscore-i
     }
 }
 
+TEST_F(ApiTest, commit_auto_dispose) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    for (bool success : { true, false }) {
+        TransactionPtr transaction;
+        {
+            jogasaki::proto::sql::response::Begin b{};
+            auto* s = b.mutable_success();
+            s->mutable_transaction_handle()->set_handle(0x12345678);
+            s->mutable_transaction_id()->set_id("transaction_id_for_test");
+            server_->response_message(b);
+            EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+            std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+            EXPECT_TRUE(request_opt);
+        }
+
+        // the transaction is disposed by the server on success, and by the client otherwise
+        jogasaki::proto::sql::response::ResultOnly roc{};
+        if (success) {
+            roc.mutable_success();
+        } else {
+            roc.mutable_error()->set_detail("commit failed for test");
+        }
+        server_->response_message(roc);
+        if (!success) {
+            jogasaki::proto::sql::response::ResultOnly rod{};
+            rod.mutable_success();
+            server_->response_message(rod);
+        }
+
+        ogawayama::stub::commit_option option{ogawayama::stub::CommitStatus::STORED, true};
+        EXPECT_EQ(success ? ERROR_CODE::OK : ERROR_CODE::SERVER_ERROR, transaction->commit(option));
+
+        std::optional<jogasaki::proto::sql::request::Request> requestc_opt = server_->request_message();
+        EXPECT_TRUE(requestc_opt);
+        auto requestc = requestc_opt.value();
+        EXPECT_EQ(requestc.request_case(), jogasaki::proto::sql::request::Request::RequestCase::kCommit);
+        EXPECT_EQ(requestc.commit().transaction_handle().handle(), 0x12345678);
+        EXPECT_EQ(requestc.commit().option().notification_type(), jogasaki::proto::sql::request::CommitStatus::STORED);
+        EXPECT_TRUE(requestc.commit().option().auto_dispose());
+
+        if (!success) {
+            std::optional<jogasaki::proto::sql::request::Request> requestd_opt = server_->request_message();
+            EXPECT_TRUE(requestd_opt);
+            auto requestd = requestd_opt.value();
+            EXPECT_EQ(requestd.request_case(), jogasaki::proto::sql::request::Request::RequestCase::kDisposeTransaction);
+        }
+        EXPECT_EQ(ERROR_CODE::NO_TRANSACTION, transaction->commit(option));
+    }
+}
+
 TEST_F(ApiTest, long_transaction) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
     StubPtr stub;
     ConnectionPtr connection;
@@ -493,4 +557,997 @@ TEST_F(ApiTest, result_set) {  // NOLINT(google-readability-avoid-underscore-in-
     }
 }
 
+TEST_F(ApiTest, execute_dump) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+    ResultSetPtr files;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+    }
+
+    {
+        // a file format at most
+        boost::property_tree::ptree option;
+        option.put(std::string(ogawayama::stub::PARQUET) + "." + ogawayama::stub::CODEC, "snappy");
+        option.put(std::string(ogawayama::stub::ARROW) + "." + ogawayama::stub::CODEC, "lz4");
+        EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, transaction->execute_dump("SELECT * FROM T2", "/tmp/dump", option, files));
+    }
+
+    {
+        // the paths of the files created
+        jogasaki::proto::sql::response::ResultSetMetadata m{};
+        m.add_columns()->set_atom_type(jogasaki::proto::sql::common::AtomType::CHARACTER);
+        std::queue<std::string> resultset{};
+        for (auto&& path : { "/tmp/dump/0.parquet", "/tmp/dump/1.parquet" }) {
+            std::string row{};
+            row.resize(8196);  // enough to write
+            takatori::util::buffer_view buf { row.data(), row.size() };
+            takatori::util::buffer_view::iterator iter = buf.begin();
+            auto end = buf.end();
+            jogasaki::serializer::write_row_begin(1, iter, end);
+            jogasaki::serializer::write_character(path, iter, end);
+            jogasaki::serializer::write_end_of_contents(iter, end);
+            row.resize(std::distance(buf.begin(), iter));
+            resultset.emplace(row);
+        }
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_with_resultset(m, resultset, ro);
+
+        boost::property_tree::ptree option;
+        option.put(ogawayama::stub::DUMP_FAIL_BEHAVIOR, ogawayama::stub::DumpFailBehavior::KEEP_FILES);
+        option.put(ogawayama::stub::MAX_RECORD_COUNT_PER_FILE, 1000);
+        option.put(ogawayama::stub::TIMESTAMP_UNIT, ogawayama::stub::TimeUnit::MICROSECOND);
+        boost::property_tree::ptree parquet;
+        parquet.put(ogawayama::stub::RECORD_BATCH_SIZE, 100);
+        parquet.put(ogawayama::stub::CODEC, "snappy");
+        boost::property_tree::ptree columns;
+        boost::property_tree::ptree column;
+        column.put(ogawayama::stub::COLUMN_NAME, "C1");
+        column.put(ogawayama::stub::ENCODING, "PLAIN");
+        columns.push_back(std::make_pair("", column));
+        parquet.add_child(ogawayama::stub::COLUMNS, columns);
+        option.add_child(ogawayama::stub::PARQUET, parquet);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_dump("SELECT * FROM T2", "/tmp/dump", option, files));
+
+        std::string_view file{};
+        EXPECT_EQ(ERROR_CODE::OK, files->next());
+        EXPECT_EQ(ERROR_CODE::OK, files->next_column(file));
+        EXPECT_EQ("/tmp/dump/0.parquet", file);
+        EXPECT_EQ(ERROR_CODE::OK, files->next());
+        EXPECT_EQ(ERROR_CODE::OK, files->next_column(file));
+        EXPECT_EQ("/tmp/dump/1.parquet", file);
+        EXPECT_EQ(ERROR_CODE::END_OF_ROW, files->next());
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        ASSERT_TRUE(request_opt);
+        auto& request = request_opt.value();
+        EXPECT_EQ(request.request_case(), jogasaki::proto::sql::request::Request::RequestCase::kExecuteDumpByText);
+        auto& dump = request.execute_dump_by_text();
+        EXPECT_EQ(dump.transaction_handle().handle(), 0x12345678);
+        EXPECT_EQ(dump.sql(), "SELECT * FROM T2");
+        EXPECT_EQ(dump.directory(), "/tmp/dump");
+        EXPECT_EQ(dump.option().fail_behavior(), jogasaki::proto::sql::request::DumpFailBehavior::KEEP_FILES);
+        EXPECT_EQ(dump.option().max_record_count_per_file(), 1000);
+        EXPECT_EQ(dump.option().timestamp_unit(), jogasaki::proto::sql::common::TimeUnit::MICROSECOND);
+        ASSERT_EQ(dump.option().file_format_case(), jogasaki::proto::sql::request::DumpOption::FileFormatCase::kParquet);
+        auto& format = dump.option().parquet();
+        EXPECT_EQ(format.record_batch_size(), 100);
+        EXPECT_EQ(format.codec(), "snappy");
+        ASSERT_EQ(format.columns_size(), 1);
+        EXPECT_EQ(format.columns(0).name(), "C1");
+        EXPECT_EQ(format.columns(0).encoding(), "PLAIN");
+    }
+
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, wait_strategy) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    boost::property_tree::ptree option;
+    option.put(ogawayama::stub::WAIT_SPIN_COUNT, 1000);
+    option.put(ogawayama::stub::WAIT_YIELD_COUNT, 100);
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16, option));
+
+    ogawayama::stub::wait_statistics before{};
+    EXPECT_EQ(ERROR_CODE::OK, connection->get_wait_statistics(before));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        jogasaki::proto::sql::response::Begin::Success s{};
+        jogasaki::proto::sql::common::Transaction t{};
+        jogasaki::proto::sql::common::TransactionId tid{};
+        tid.set_id("transaction_id_for_test");
+        t.set_handle(0x12345678);
+        s.set_allocated_transaction_handle(&t);
+        s.set_allocated_transaction_id(&tid);
+        b.set_allocated_success(&s);
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+        (void) s.release_transaction_handle();
+        (void) s.release_transaction_id();
+        (void) b.release_success();
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+        EXPECT_EQ(request_opt.value().request_case(), jogasaki::proto::sql::request::Request::RequestCase::kBegin);
+    }
+
+    ogawayama::stub::wait_statistics after{};
+    EXPECT_EQ(ERROR_CODE::OK, connection->get_wait_statistics(after));
+    EXPECT_EQ((before.immediate + before.spin + before.yield + before.block) + 1,
+              after.immediate + after.spin + after.yield + after.block);
+
+    {
+        jogasaki::proto::sql::response::ResultOnly roc{};
+        jogasaki::proto::sql::response::Success sc{};
+        roc.set_allocated_success(&sc);
+        server_->response_message(roc);
+
+        jogasaki::proto::sql::response::ResultOnly rod{};
+        jogasaki::proto::sql::response::Success sd{};
+        rod.set_allocated_success(&sd);
+        server_->response_message(rod);
+
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+        (void) roc.release_success();
+        (void) rod.release_success();
+    }
+}
+
+TEST_F(ApiTest, slot_count) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    boost::property_tree::ptree invalid_option;
+    invalid_option.put(ogawayama::stub::SLOT_COUNT, 0);
+    EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, stub->get_connection(connection, 16, invalid_option));
+
+    // every request reuses the only slot
+    boost::property_tree::ptree option;
+    option.put(ogawayama::stub::SLOT_COUNT, 1);
+    option.put(ogawayama::stub::SLOT_BLOCKING, true);
+    option.put(ogawayama::stub::SLOT_TIMEOUT, 1000);
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16, option));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+        EXPECT_EQ(request_opt.value().request_case(), jogasaki::proto::sql::request::Request::RequestCase::kBegin);
+    }
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, response_dispatcher) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    boost::property_tree::ptree option;
+    option.put(ogawayama::stub::RESPONSE_DISPATCHER, true);
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16, option));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+        EXPECT_EQ(request_opt.value().request_case(), jogasaki::proto::sql::request::Request::RequestCase::kBegin);
+    }
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, deferred_disposal) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    boost::property_tree::ptree invalid_option;
+    invalid_option.put(ogawayama::stub::DEFERRED_DISPOSAL, true);
+    invalid_option.put(ogawayama::stub::DISPOSAL_QUEUE_SIZE, tateyama::common::wire::slot_policy::default_count);
+    EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, stub->get_connection(connection, 16, invalid_option));
+
+    // the default queue size can use up the slots
+    boost::property_tree::ptree few_slots_option;
+    few_slots_option.put(ogawayama::stub::DEFERRED_DISPOSAL, true);
+    few_slots_option.put(ogawayama::stub::SLOT_COUNT, 4);
+    EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, stub->get_connection(connection, 16, few_slots_option));
+
+    boost::property_tree::ptree option;
+    option.put(ogawayama::stub::DEFERRED_DISPOSAL, true);
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16, option));
+
+    jogasaki::proto::sql::response::Begin b{};
+    auto* s = b.mutable_success();
+    s->mutable_transaction_handle()->set_handle(0x12345678);
+    s->mutable_transaction_id()->set_id("transaction_id_for_test");
+    jogasaki::proto::sql::response::ResultOnly ro{};
+    ro.mutable_success();
+
+    server_->response_message(b);
+    EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+    // the rollback of the transaction abandoned is sent, and its response is received by the next begin,
+    // which sends the dispose before itself
+    server_->response_message(ro);
+    server_->response_message(ro);
+    s->mutable_transaction_handle()->set_handle(0x23456789);
+    server_->response_message(b);
+    transaction = nullptr;
+    EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+    // the dispose following the commit is received when the connection is closed
+    server_->response_message(ro);
+    server_->response_message(ro);
+    EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    transaction = nullptr;
+    connection = nullptr;
+
+    using RequestCase = jogasaki::proto::sql::request::Request::RequestCase;
+    std::vector<std::pair<RequestCase, std::uint64_t>> expected{
+        { RequestCase::kBegin, 0 },
+        { RequestCase::kRollback, 0x12345678 },
+        { RequestCase::kDisposeTransaction, 0x12345678 },
+        { RequestCase::kBegin, 0 },
+        { RequestCase::kCommit, 0x23456789 },
+        { RequestCase::kDisposeTransaction, 0x23456789 },
+    };
+    for (auto&& [request_case, handle] : expected) {
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        ASSERT_TRUE(request_opt);
+        auto& request = request_opt.value();
+        EXPECT_EQ(request.request_case(), request_case);
+        switch (request_case) {
+        case RequestCase::kRollback:
+            EXPECT_EQ(request.rollback().transaction_handle().handle(), handle);
+            break;
+        case RequestCase::kDisposeTransaction:
+            EXPECT_EQ(request.dispose_transaction().transaction_handle().handle(), handle);
+            break;
+        case RequestCase::kCommit:
+            EXPECT_EQ(request.commit().transaction_handle().handle(), handle);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+TEST_F(ApiTest, connection_pool) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    // the sessions taken from the pool are checked by the lock file of the server, which is held here
+    int fd = open("dummy_mutex_file", O_RDWR | O_CREAT, 0600);  // NOLINT
+    ASSERT_LE(0, fd);
+    ASSERT_EQ(0, flock(fd, LOCK_EX));
+
+    StubPtr stub;
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    boost::property_tree::ptree option;
+    option.put(ogawayama::stub::DEFERRED_DISPOSAL, true);
+
+    boost::property_tree::ptree pool_option;
+    pool_option.put(ogawayama::stub::POOL_MIN_SIZE, 2);
+    pool_option.put(ogawayama::stub::POOL_MAX_SIZE, 1);
+    EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, stub->open_connection_pool(pool_option, option));
+    pool_option.put(ogawayama::stub::POOL_MIN_SIZE, 1);
+    EXPECT_EQ(ERROR_CODE::OK, stub->open_connection_pool(pool_option, option));
+
+    jogasaki::proto::sql::response::Begin b{};
+    auto* s = b.mutable_success();
+    s->mutable_transaction_handle()->set_handle(0x12345678);
+    s->mutable_transaction_id()->set_id("transaction_id_for_test");
+    jogasaki::proto::sql::response::ResultOnly ro{};
+    ro.mutable_success();
+
+    // the test server accepts only one session, which is connected by the pool and serves every connection,
+    // the dispose pending being received when the session is returned
+    for (std::size_t i = 0; i < 2; i++) {
+        ConnectionPtr connection;
+        TransactionPtr transaction;
+        EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16, option));
+
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+    stub->close_connection_pool();
+
+    using RequestCase = jogasaki::proto::sql::request::Request::RequestCase;
+    for (std::size_t i = 0; i < 2; i++) {
+        for (auto request_case : { RequestCase::kBegin, RequestCase::kCommit, RequestCase::kDisposeTransaction }) {
+            std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+            ASSERT_TRUE(request_opt);
+            EXPECT_EQ(request_opt.value().request_case(), request_case);
+        }
+    }
+
+    flock(fd, LOCK_UN);
+    close(fd);
+    unlink("dummy_mutex_file");
+}
+
+TEST_F(ApiTest, result_set_mirroring) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::int32_t rows = 48;  // fits in the result set buffer of the test server
+
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+    ResultSetPtr result_set;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    boost::property_tree::ptree option;
+    option.put(ogawayama::stub::RESULTSET_MIRRORING, true);
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16, option));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+    }
+
+    auto text_of = [](std::int32_t i) {
+        return std::string(1000 + (i % 7), static_cast<char>('A' + (i % 26)));
+    };
+    {
+        jogasaki::proto::sql::response::ResultSetMetadata m{};
+        m.add_columns()->set_atom_type(jogasaki::proto::sql::common::AtomType::INT4);
+        m.add_columns()->set_atom_type(jogasaki::proto::sql::common::AtomType::CHARACTER);
+        std::queue<std::string> resultset{};
+        for (std::int32_t i = 0; i < rows; i++) {
+            std::string row{};
+            row.resize(8196);  // enough to write
+            takatori::util::buffer_view buf { row.data(), row.size() };
+            takatori::util::buffer_view::iterator iter = buf.begin();
+            auto end = buf.end();
+            jogasaki::serializer::write_row_begin(2, iter, end);
+            jogasaki::serializer::write_int(i, iter, end);
+            jogasaki::serializer::write_character(text_of(i), iter, end);
+            jogasaki::serializer::write_end_of_contents(iter, end);
+            row.resize(std::distance(buf.begin(), iter));
+            resultset.emplace(row);
+        }
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_with_resultset(m, resultset, ro);
+
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+
+        std::int32_t count{};
+        while (result_set->next() == ERROR_CODE::OK) {
+            std::int32_t i{};
+            std::string_view t;
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(i));
+            EXPECT_EQ(count, i);
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(t));
+            EXPECT_EQ(text_of(count), t);
+            count++;
+        }
+        EXPECT_EQ(rows, count);
+    }
+
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, result_set_release_batch) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::int32_t rows = 100;
+    static constexpr std::size_t batch = 16;
+
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+    ResultSetPtr result_set;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+    }
+
+    {
+        jogasaki::proto::sql::response::ResultSetMetadata m{};
+        m.add_columns()->set_atom_type(jogasaki::proto::sql::common::AtomType::INT4);
+        std::queue<std::string> resultset{};
+        for (std::int32_t i = 0; i < rows; i++) {
+            std::string row{};
+            row.resize(64);  // enough to write
+            takatori::util::buffer_view buf { row.data(), row.size() };
+            takatori::util::buffer_view::iterator iter = buf.begin();
+            auto end = buf.end();
+            jogasaki::serializer::write_row_begin(1, iter, end);
+            jogasaki::serializer::write_int(i, iter, end);
+            jogasaki::serializer::write_end_of_contents(iter, end);
+            row.resize(std::distance(buf.begin(), iter));
+            resultset.emplace(row);
+        }
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_with_resultset(m, resultset, ro);
+
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+        EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, result_set->set_release_batch(0));
+        EXPECT_EQ(ERROR_CODE::OK, result_set->set_release_batch(batch));
+
+        std::int32_t count{};
+        while (result_set->next() == ERROR_CODE::OK) {
+            std::int32_t i{};
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(i));
+            EXPECT_EQ(count, i);
+            count++;
+        }
+        EXPECT_EQ(rows, count);
+
+        ogawayama::stub::release_statistics statistics{};
+        EXPECT_EQ(ERROR_CODE::OK, result_set->get_release_statistics(statistics));
+        EXPECT_EQ(rows, statistics.records);
+        EXPECT_LT(statistics.releases, rows);
+        EXPECT_GE(statistics.releases, (rows + batch - 1) / batch);
+    }
+
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, synthetic_resultset) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::size_t rows = 10000;  // far more than the result set buffer holds
+
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+    ResultSetPtr result_set;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+    }
+
+    {
+        synthetic_resultset resultset{{
+                {jogasaki::proto::sql::common::AtomType::INT8, 0.0, 0},
+                {jogasaki::proto::sql::common::AtomType::CHARACTER, 0.5, 100}
+            }, rows};
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_with_resultset(resultset, ro);
+
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+
+        std::size_t count{};
+        std::size_t nulls{};
+        while (result_set->next() == ERROR_CODE::OK) {
+            std::int64_t i{};
+            std::string_view t;
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(i));
+            if (auto rc = result_set->next_column(t); rc == ERROR_CODE::COLUMN_WAS_NULL) {
+                nulls++;
+            } else {
+                EXPECT_EQ(ERROR_CODE::OK, rc);
+                EXPECT_EQ(100, t.length());
+            }
+            count++;
+        }
+        EXPECT_EQ(rows, count);
+        EXPECT_GT(nulls, 0);
+        EXPECT_LT(nulls, rows);
+    }
+
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, next_batch_and_read_row) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::size_t rows = 10000;
+    static constexpr std::size_t batch_size = 300;
+
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+    ResultSetPtr result_set;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+    }
+
+    synthetic_resultset resultset{{
+            {jogasaki::proto::sql::common::AtomType::INT8, 0.1, 0},
+            {jogasaki::proto::sql::common::AtomType::CHARACTER, 0.5, 20},
+            {jogasaki::proto::sql::common::AtomType::FLOAT8, 0.0, 0}
+        }, rows};
+    jogasaki::proto::sql::response::ResultOnly ro{};
+    ro.mutable_success();
+
+    // read row by row for the expected values
+    std::vector<std::optional<std::int64_t>> ints{};
+    std::vector<std::optional<std::string>> texts{};
+    std::vector<double> floats{};
+    {
+        server_->response_with_resultset(resultset, ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+        while (result_set->next() == ERROR_CODE::OK) {
+            std::int64_t i{};
+            std::string_view t;
+            double f{};
+            ints.emplace_back(result_set->next_column(i) == ERROR_CODE::OK ? std::optional<std::int64_t>{i} : std::nullopt);
+            texts.emplace_back(result_set->next_column(t) == ERROR_CODE::OK ? std::optional<std::string>{t} : std::nullopt);
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(f));
+            floats.emplace_back(f);
+        }
+        EXPECT_EQ(rows, ints.size());
+    }
+
+    {
+        resultset.rewind();
+        server_->response_with_resultset(resultset, ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+
+        ogawayama::stub::row_batch batch{};
+        std::size_t count{};
+        std::size_t batches{};
+        while (result_set->next_batch(batch_size, batch) == ERROR_CODE::OK) {
+            EXPECT_LE(batch.size(), batch_size);
+            EXPECT_EQ(3, batch.column_count());
+            auto& c0 = batch.column(0);
+            auto& c1 = batch.column(1);
+            auto& c2 = batch.column(2);
+            for (std::size_t i = 0; i < batch.size(); i++, count++) {
+                EXPECT_EQ(ints.at(count).has_value(), !c0.is_null(i));
+                if (!c0.is_null(i)) {
+                    EXPECT_EQ(ints.at(count).value(), c0.values<std::int64_t>().at(i));
+                }
+                EXPECT_EQ(texts.at(count).has_value(), !c1.is_null(i));
+                if (!c1.is_null(i)) {
+                    EXPECT_EQ(texts.at(count).value(), c1.text(i));
+                }
+                EXPECT_FALSE(c2.is_null(i));
+                EXPECT_EQ(floats.at(count), c2.values<double>().at(i));
+            }
+            batches++;
+        }
+        EXPECT_EQ(rows, count);
+        EXPECT_EQ((rows + batch_size - 1) / batch_size, batches);
+        EXPECT_TRUE(batch.empty());
+        EXPECT_EQ(ERROR_CODE::END_OF_ROW, result_set->next_batch(batch_size, batch));
+    }
+
+    {
+        resultset.rewind();
+        server_->response_with_resultset(resultset, ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+
+        std::vector<ogawayama::stub::value_type> row{};
+        std::size_t count{};
+        while (result_set->read_row(row) == ERROR_CODE::OK) {
+            EXPECT_EQ(3, row.size());
+            if (ints.at(count)) {
+                EXPECT_EQ(ints.at(count).value(), std::get<std::int64_t>(row.at(0)));
+            } else {
+                EXPECT_TRUE(std::holds_alternative<std::monostate>(row.at(0)));
+            }
+            if (texts.at(count)) {
+                EXPECT_EQ(texts.at(count).value(), std::get<std::string>(row.at(1)));
+            } else {
+                EXPECT_TRUE(std::holds_alternative<std::monostate>(row.at(1)));
+            }
+            EXPECT_EQ(floats.at(count), std::get<double>(row.at(2)));
+            count++;
+        }
+        EXPECT_EQ(rows, count);
+    }
+
+    {
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, row_batch_truncate) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    using Type = ogawayama::stub::Metadata::ColumnType::Type;
+
+    // the columns of a row decoded partway are truncated back to the last complete row
+    ogawayama::stub::column_vector numbers{Type::INT64};
+    ogawayama::stub::column_vector texts{Type::TEXT};
+    for (std::size_t i = 0; i < 100; i++) {
+        if (i % 3 == 0) {
+            numbers.push_null();
+            texts.push_null();
+        } else {
+            numbers.push(static_cast<std::int64_t>(i));
+            texts.push_text(std::to_string(i));
+        }
+    }
+    numbers.truncate(70);
+    texts.truncate(70);
+
+    EXPECT_EQ(70, numbers.size());
+    EXPECT_EQ(24, numbers.null_count());
+    EXPECT_EQ(70, numbers.values<std::int64_t>().size());
+    EXPECT_EQ(68, numbers.values<std::int64_t>().at(68));
+    EXPECT_EQ(70, texts.size());
+    EXPECT_EQ(24, texts.null_count());
+    EXPECT_EQ(71, texts.offsets().size());
+    EXPECT_EQ(texts.offsets().back(), texts.bytes().size());
+    EXPECT_EQ("68", texts.text(68));
+    EXPECT_TRUE(texts.is_null(69));
+
+    // the rows appended next are not taken for the ones removed
+    numbers.push(static_cast<std::int64_t>(1000));
+    texts.push_text("1000");
+    EXPECT_FALSE(numbers.is_null(70));
+    EXPECT_FALSE(texts.is_null(70));
+    EXPECT_EQ(1000, numbers.values<std::int64_t>().at(70));
+    EXPECT_EQ("1000", texts.text(70));
+}
+
+TEST_F(ApiTest, next_batch_runs) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::size_t rows = 1000;
+
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+    ResultSetPtr result_set;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+    }
+
+    // runs of the same type, broken by NULLs here and there
+    synthetic_resultset resultset{{
+            {jogasaki::proto::sql::common::AtomType::INT8, 0.2, 0},
+            {jogasaki::proto::sql::common::AtomType::INT8, 0.0, 0},
+            {jogasaki::proto::sql::common::AtomType::INT8, 0.2, 0},
+            {jogasaki::proto::sql::common::AtomType::FLOAT8, 0.3, 0},
+            {jogasaki::proto::sql::common::AtomType::FLOAT8, 0.0, 0},
+            {jogasaki::proto::sql::common::AtomType::INT4, 0.1, 0},
+            {jogasaki::proto::sql::common::AtomType::INT4, 0.1, 0},
+            {jogasaki::proto::sql::common::AtomType::FLOAT4, 0.1, 0},
+            {jogasaki::proto::sql::common::AtomType::FLOAT4, 0.0, 0}
+        }, rows};
+    jogasaki::proto::sql::response::ResultOnly ro{};
+    ro.mutable_success();
+
+    // read_row() decodes column by column for the expected values
+    std::vector<std::vector<ogawayama::stub::value_type>> expected{};
+    {
+        server_->response_with_resultset(resultset, ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+        std::vector<ogawayama::stub::value_type> row{};
+        while (result_set->read_row(row) == ERROR_CODE::OK) {
+            expected.emplace_back(row);
+        }
+        EXPECT_EQ(rows, expected.size());
+    }
+
+    {
+        resultset.rewind();
+        server_->response_with_resultset(resultset, ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+
+        ogawayama::stub::row_batch batch{};
+        std::size_t count{};
+        while (result_set->next_batch(100, batch) == ERROR_CODE::OK) {
+            EXPECT_EQ(9, batch.column_count());
+            for (std::size_t i = 0; i < batch.size(); i++, count++) {
+                const auto& row = expected.at(count);
+                for (std::size_t c = 0; c < batch.column_count(); c++) {
+                    const auto& column = batch.column(c);
+                    EXPECT_EQ(std::holds_alternative<std::monostate>(row.at(c)), column.is_null(i));
+                    if (column.is_null(i)) {
+                        continue;
+                    }
+                    switch (column.type()) {
+                    case ogawayama::stub::Metadata::ColumnType::Type::INT32:
+                        EXPECT_EQ(std::get<std::int32_t>(row.at(c)), column.values<std::int32_t>().at(i));
+                        break;
+                    case ogawayama::stub::Metadata::ColumnType::Type::INT64:
+                        EXPECT_EQ(std::get<std::int64_t>(row.at(c)), column.values<std::int64_t>().at(i));
+                        break;
+                    case ogawayama::stub::Metadata::ColumnType::Type::FLOAT32:
+                        EXPECT_EQ(std::get<float>(row.at(c)), column.values<float>().at(i));
+                        break;
+                    case ogawayama::stub::Metadata::ColumnType::Type::FLOAT64:
+                        EXPECT_EQ(std::get<double>(row.at(c)), column.values<double>().at(i));
+                        break;
+                    default:
+                        FAIL();
+                    }
+                }
+            }
+        }
+        EXPECT_EQ(rows, count);
+    }
+
+    {
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, row_reader) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::size_t rows = 1000;
+
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+    ResultSetPtr result_set;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+    }
+
+    synthetic_resultset resultset{{
+            {jogasaki::proto::sql::common::AtomType::INT8, 0.0, 0},
+            {jogasaki::proto::sql::common::AtomType::CHARACTER, 0.5, 20},
+            {jogasaki::proto::sql::common::AtomType::DATE, 0.0, 0}
+        }, rows};
+    jogasaki::proto::sql::response::ResultOnly ro{};
+    ro.mutable_success();
+
+    {
+        server_->response_with_resultset(resultset, ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+
+        ogawayama::stub::RowReader<std::int64_t, std::string_view, ogawayama::stub::date_type> reader{*result_set};
+        EXPECT_EQ(ERROR_CODE::OK, reader.status());
+        decltype(reader)::row_type row{};
+        std::size_t count{};
+        std::size_t nulls{};
+        while (reader.next(row) == ERROR_CODE::OK) {
+            EXPECT_TRUE(std::get<0>(row).has_value());
+            if (auto& text = std::get<1>(row); text) {
+                EXPECT_EQ(20, text->length());
+            } else {
+                nulls++;
+            }
+            EXPECT_TRUE(std::get<2>(row).has_value());
+            count++;
+        }
+        EXPECT_EQ(rows, count);
+        EXPECT_GT(nulls, 0);
+    }
+
+    {
+        resultset.rewind();
+        server_->response_with_resultset(resultset, ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+
+        ogawayama::stub::RowReader<std::int64_t, std::string_view, double> reader{*result_set};
+        EXPECT_EQ(ERROR_CODE::COLUMN_TYPE_MISMATCH, reader.status());
+        decltype(reader)::row_type row{};
+        EXPECT_EQ(ERROR_CODE::COLUMN_TYPE_MISMATCH, reader.next(row));
+        ogawayama::stub::RowReader<std::int64_t, std::string_view> fewer{*result_set};
+        EXPECT_EQ(ERROR_CODE::COLUMN_TYPE_MISMATCH, fewer.status());
+        result_set = nullptr;
+    }
+
+    {
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(ApiTest, skip_columns_and_rows) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::size_t rows = 100;
+
+    StubPtr stub;
+    ConnectionPtr connection;
+    TransactionPtr transaction;
+    ResultSetPtr result_set;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+    }
+
+    synthetic_resultset resultset{{
+            {jogasaki::proto::sql::common::AtomType::INT8, 0.0, 0},
+            {jogasaki::proto::sql::common::AtomType::CHARACTER, 0.0, 100},
+            {jogasaki::proto::sql::common::AtomType::DECIMAL, 0.0, 0},
+            {jogasaki::proto::sql::common::AtomType::TIME_POINT, 0.0, 0},
+            {jogasaki::proto::sql::common::AtomType::INT4, 0.0, 0}
+        }, rows};
+    jogasaki::proto::sql::response::ResultOnly ro{};
+    ro.mutable_success();
+    auto query = [&]() {
+        resultset.rewind();
+        server_->response_with_resultset(resultset, ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_query("SELECT * FROM T2", result_set));
+    };
+
+    std::vector<std::vector<ogawayama::stub::value_type>> expected{};
+    {
+        query();
+        std::vector<ogawayama::stub::value_type> row{};
+        while (result_set->read_row(row) == ERROR_CODE::OK) {
+            expected.emplace_back(row);
+        }
+        EXPECT_EQ(rows, expected.size());
+    }
+
+    // skip_columns() passes over the columns between the ones read
+    {
+        query();
+        std::size_t count{};
+        while (result_set->next() == ERROR_CODE::OK) {
+            std::int64_t i8{};
+            takatori::datetime::time_point tp{};
+            std::int32_t i4{};
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(i8));
+            EXPECT_EQ(ERROR_CODE::OK, result_set->skip_columns(2));
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(tp));
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(i4));
+            EXPECT_EQ(std::get<std::int64_t>(expected.at(count).at(0)), i8);
+            EXPECT_EQ(std::get<ogawayama::stub::timestamp_type>(expected.at(count).at(3)), tp);
+            EXPECT_EQ(std::get<std::int32_t>(expected.at(count).at(4)), i4);
+            EXPECT_EQ(ERROR_CODE::END_OF_COLUMN, result_set->skip_columns(1));
+            count++;
+        }
+        EXPECT_EQ(rows, count);
+    }
+
+    // next_column() returns the columns in the projection only
+    {
+        query();
+        EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, result_set->set_projection({true, false}));
+        EXPECT_EQ(ERROR_CODE::OK, result_set->set_projection({false, true, false, false, true}));
+        std::size_t count{};
+        while (result_set->next() == ERROR_CODE::OK) {
+            std::string_view text{};
+            std::int32_t i4{};
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(text));
+            EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(i4));
+            EXPECT_EQ(std::get<std::string>(expected.at(count).at(1)), text);
+            EXPECT_EQ(std::get<std::int32_t>(expected.at(count).at(4)), i4);
+            count++;
+        }
+        EXPECT_EQ(rows, count);
+    }
+
+    // skip_rows() passes over whole rows, with or without the current row read partway
+    {
+        query();
+        std::int64_t i8{};
+        EXPECT_EQ(ERROR_CODE::OK, result_set->next());
+        EXPECT_EQ(ERROR_CODE::OK, result_set->skip_rows(10));
+        EXPECT_EQ(ERROR_CODE::OK, result_set->next());
+        EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(i8));
+        EXPECT_EQ(std::get<std::int64_t>(expected.at(11).at(0)), i8);
+        EXPECT_EQ(ERROR_CODE::OK, result_set->skip_rows(10));
+        EXPECT_EQ(ERROR_CODE::OK, result_set->next());
+        EXPECT_EQ(ERROR_CODE::OK, result_set->next_column(i8));
+        EXPECT_EQ(std::get<std::int64_t>(expected.at(22).at(0)), i8);
+        EXPECT_EQ(ERROR_CODE::END_OF_ROW, result_set->skip_rows(rows));
+        EXPECT_EQ(ERROR_CODE::END_OF_ROW, result_set->next());
+    }
+
+    {
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
 }  // namespace ogawayama::testing
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include <jogasaki/serializer/details/decimal_coefficient.h>
+#include <jogasaki/serializer/value_input.h>
+#include <jogasaki/serializer/value_output.h>
+
+namespace ogawayama::testing {
+
+using takatori::decimal::triple;
+using jogasaki::serializer::details::decimal_coefficient_buffer;
+using jogasaki::serializer::details::decode_decimal_coefficient;
+using jogasaki::serializer::details::encode_decimal_coefficient;
+
+// triples are compared by EXPECT_TRUE, as operator<< of them is not linked to the tests
+class DecimalTest : public ::testing::Test {
+protected:
+    std::mt19937_64 engine_{};  // NOLINT
+
+    // a decimal of random sign, coefficient width and exponent
+    triple random_triple() {
+        auto width = engine_() % 129;
+        std::uint64_t high = engine_();
+        std::uint64_t low = engine_();
+        if (width <= 64) {
+            high = 0;
+            low = width == 64 ? low : low & ((1ULL << width) - 1U);
+        } else if (width < 128) {
+            high &= (1ULL << (width - 64)) - 1U;
+        }
+        auto sign = (engine_() & 1U) != 0 ? -1 : +1;
+        auto exponent = static_cast<std::int32_t>(engine_() % 64) - 32;
+        return triple{sign, high, low, exponent};
+    }
+
+    // the minimum two's complement octets, computed by multi-precision arithmetic
+    static std::string reference(triple value) {
+        boost::multiprecision::cpp_int v = value.coefficient_high();
+        v <<= 64;
+        v |= value.coefficient_low();
+        if (value.sign() < 0) {
+            v = -v;
+        }
+        std::string out(jogasaki::serializer::details::max_decimal_coefficient_size, '\0');
+        for (std::size_t i = 0; i < out.size(); i++) {
+            out[out.size() - 1 - i] = static_cast<char>(static_cast<std::uint8_t>((v >> (i * 8)) & 0xff));
+        }
+        std::size_t skip = 0;
+        while (skip < out.size() - 1) {
+            auto octet = static_cast<std::uint8_t>(out[skip]);
+            auto next = static_cast<std::uint8_t>(out[skip + 1]);
+            if ((octet == 0x00U && (next & 0x80U) == 0) || (octet == 0xffU && (next & 0x80U) != 0)) {
+                skip++;
+                continue;
+            }
+            break;
+        }
+        return out.substr(skip);
+    }
+};
+
+TEST_F(DecimalTest, encode_boundaries) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    decimal_coefficient_buffer buffer{};
+    EXPECT_EQ(std::string(1, '\x00'), encode_decimal_coefficient(triple{0, 0, 0, 0}, buffer));
+    EXPECT_EQ(std::string("\x7f"), encode_decimal_coefficient(triple{+1, 0, 127, 0}, buffer));
+    EXPECT_EQ(std::string("\x00\x80", 2), encode_decimal_coefficient(triple{+1, 0, 128, 0}, buffer));
+    EXPECT_EQ(std::string("\xff"), encode_decimal_coefficient(triple{-1, 0, 1, 0}, buffer));
+    EXPECT_EQ(std::string("\x80"), encode_decimal_coefficient(triple{-1, 0, 128, 0}, buffer));
+    EXPECT_EQ(std::string("\xff\x7f"), encode_decimal_coefficient(triple{-1, 0, 129, 0}, buffer));
+
+    // 2^128 - 1 and its negative take the 17th octet for the sign
+    auto max = encode_decimal_coefficient(triple{+1, ~0ULL, ~0ULL, 0}, buffer);
+    EXPECT_EQ(std::string(1, '\x00') + std::string(16, '\xff'), max);
+    auto min = encode_decimal_coefficient(triple{-1, ~0ULL, ~0ULL, 0}, buffer);
+    EXPECT_EQ(std::string(1, '\xff') + std::string(15, '\x00') + std::string(1, '\x01'), min);
+    EXPECT_TRUE((triple{-1, ~0ULL, ~0ULL, 3}) == decode_decimal_coefficient(min, 3));
+}
+
+TEST_F(DecimalTest, round_trip) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    decimal_coefficient_buffer buffer{};
+    for (std::size_t i = 0; i < 100000; i++) {
+        auto value = random_triple();
+        auto coefficient = encode_decimal_coefficient(value, buffer);
+        if (value.sign() != 0) {
+            ASSERT_EQ(reference(value), coefficient) << i;
+        }
+        ASSERT_TRUE(value == decode_decimal_coefficient(coefficient, value.exponent())) << i;
+    }
+}
+
+TEST_F(DecimalTest, serializer_round_trip) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    std::vector<triple> values{};
+    for (std::size_t i = 0; i < 10000; i++) {
+        values.emplace_back(random_triple());
+    }
+    std::vector<char> buffer(values.size() * 32);
+    jogasaki::serializer::buffer_view view{buffer.data(), buffer.size()};
+    auto out = view.begin();
+    for (auto&& value : values) {
+        ASSERT_TRUE(jogasaki::serializer::write_decimal(value, out, view.end()));
+    }
+
+    jogasaki::serializer::buffer_view::const_iterator in = view.begin();
+    for (auto&& value : values) {
+        ASSERT_TRUE(value == jogasaki::serializer::read_decimal(in, out));
+    }
+    EXPECT_EQ(in, out);
+}
+
+}  // namespace ogawayama::testing
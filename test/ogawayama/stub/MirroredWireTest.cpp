@@ -0,0 +1,92 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "tateyama/transport/client_wire.h"
+
+namespace ogawayama::testing {
+
+static constexpr const char* name_prefix = "mirrored_wire_test";
+
+class MirroredWireTest : public ::testing::Test {
+    void SetUp() override {
+        shm_name_ = std::string(name_prefix);
+        shm_name_ += std::to_string(getpid());
+        boost::interprocess::shared_memory_object::remove(shm_name_.c_str());
+        managed_shm_ = std::make_unique<boost::interprocess::managed_shared_memory>(boost::interprocess::create_only, shm_name_.c_str(), shm_size);
+    }
+    void TearDown() override {
+        managed_shm_ = nullptr;
+        boost::interprocess::shared_memory_object::remove(shm_name_.c_str());
+    }
+protected:
+    static constexpr std::size_t shm_size = 1024 * 1024;
+    static constexpr std::size_t buffer_size = 64 * 1024;
+
+    std::string shm_name_{};  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,misc-non-private-member-variables-in-classes)
+    std::unique_ptr<boost::interprocess::managed_shared_memory> managed_shm_{};  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,misc-non-private-member-variables-in-classes)
+};
+
+TEST_F(MirroredWireTest, wrap_around) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::size_t records = 1024;  // wraps around the buffer several times
+
+    auto* wires = managed_shm_->construct<tateyama::common::wire::unidirectional_simple_wires>("resultset")(managed_shm_.get(), 1, buffer_size);
+    auto* wire = wires->acquire();
+
+    auto offset = static_cast<std::size_t>(wire->get_handle());
+    ASSERT_TRUE(tateyama::common::wire::mirrored_mapping::mappable(offset, wire->get_capacity()));
+    int fd = shm_open(("/" + shm_name_).c_str(), O_RDONLY, 0);
+    ASSERT_GE(fd, 0);
+    tateyama::common::wire::mirrored_mapping mirror(fd, offset, wire->get_capacity());
+    ::close(fd);
+
+    auto record_of = [](std::size_t i) {
+        return std::string(1000 + (i % 7), static_cast<char>('A' + (i % 26)));
+    };
+
+    std::thread writer([wires, wire, &record_of](){
+        for (std::size_t i = 0; i < records; i++) {
+            auto record = record_of(i);
+            wire->write(record.data(), record.length());
+            wire->flush();
+        }
+        wires->set_eor();
+    });
+
+    std::size_t received{};
+    std::size_t mismatches{};
+    while (wires->active_wire() != nullptr) {
+        auto chunk = wire->get_chunk_mirrored(mirror.base());
+        if (chunk != record_of(received)) {
+            mismatches++;
+        }
+        wire->release(wire->chunk_size());
+        received++;
+    }
+    writer.join();
+
+    EXPECT_EQ(records, received);
+    EXPECT_EQ(0, mismatches);
+}
+
+}  // namespace ogawayama::testing
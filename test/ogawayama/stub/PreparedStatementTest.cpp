@@ -275,4 +275,417 @@ TEST_F(PreparedTest, prepare) {
     }
 }
 
+TEST_F(PreparedTest, execute_statement_async) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    PreparedStatementPtr prepared_statement;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Prepare rp{};
+        auto ps = rp.mutable_prepared_statement_handle();
+        ps->set_handle(1234);
+        ps->set_has_result_records(false);
+        server_->response_message(rp);
+
+        ogawayama::stub::placeholders_type placeholders{};
+        placeholders.emplace_back("int32_data", ogawayama::stub::Metadata::ColumnType::Type::INT32);
+        auto future = connection->prepare_async("insert into table (c1) values(:int32_data)", placeholders, prepared_statement);
+        EXPECT_EQ(ERROR_CODE::OK, future.get());
+        EXPECT_TRUE(prepared_statement);
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+        EXPECT_EQ(request_opt.value().request_case(), ::jogasaki::proto::sql::request::Request::RequestCase::kPrepare);
+    }
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+        EXPECT_EQ(request_opt.value().request_case(), ::jogasaki::proto::sql::request::Request::RequestCase::kBegin);
+    }
+
+    {
+        for (std::int64_t i = 1; i <= 3; i++) {
+            jogasaki::proto::sql::response::ExecuteResult er{};
+            auto* c = er.mutable_success()->add_counters();
+            c->set_type(jogasaki::proto::sql::response::ExecuteResult::INSERTED_ROWS);
+            c->set_value(i);
+            server_->response_message(er);
+        }
+
+        ogawayama::stub::parameters_type parameters{};
+        parameters.emplace_back("int32_data", static_cast<std::int32_t>(123456));
+        std::size_t num_rows1{};
+        std::size_t num_rows2{};
+        std::size_t num_rows3{};
+        auto future1 = transaction->execute_statement_async(prepared_statement, parameters, num_rows1);
+        auto future2 = transaction->execute_statement_async(prepared_statement, parameters, num_rows2);
+        {
+            // dropped without being resolved, the response is received and discarded
+            auto future3 = transaction->execute_statement_async(prepared_statement, parameters, num_rows3);
+        }
+        EXPECT_EQ(0, num_rows3);
+
+        EXPECT_EQ(ERROR_CODE::OK, future2.get());
+        EXPECT_EQ(2, num_rows2);
+        EXPECT_EQ(ERROR_CODE::OK, future1.get());
+        EXPECT_EQ(1, num_rows1);
+
+        for (std::size_t i = 0; i < 3; i++) {
+            std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+            EXPECT_TRUE(request_opt);
+            EXPECT_EQ(request_opt.value().request_case(), ::jogasaki::proto::sql::request::Request::RequestCase::kExecutePreparedStatement);
+        }
+    }
+
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit_async().get());
+    }
+}
+
+TEST_F(PreparedTest, parameter_binder) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    PreparedStatementPtr prepared_statement;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Prepare rp{};
+        auto ps = rp.mutable_prepared_statement_handle();
+        ps->set_handle(1234);
+        ps->set_has_result_records(false);
+        server_->response_message(rp);
+
+        std::future<ERROR_CODE> future{};
+        {
+            // the placeholders are kept by the prepared statement
+            ogawayama::stub::placeholders_type placeholders{};
+            placeholders.emplace_back("int64_data", ogawayama::stub::Metadata::ColumnType::Type::INT64);
+            placeholders.emplace_back("text_data", ogawayama::stub::Metadata::ColumnType::Type::TEXT);
+            placeholders.emplace_back("decimal_data", ogawayama::stub::Metadata::ColumnType::Type::DECIMAL);
+            future = connection->prepare_async("insert into table (c1, c2, c3) values(:int64_data, :text_data, :decimal_data)", placeholders, prepared_statement);
+        }
+        EXPECT_EQ(ERROR_CODE::OK, future.get());
+        EXPECT_TRUE(prepared_statement);
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+    }
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+    }
+
+    ogawayama::stub::ParameterBinder binder{prepared_statement};
+    EXPECT_EQ(3, binder.size());
+    EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, binder.set(3, static_cast<std::int64_t>(1)));
+    {
+        ResultSetPtr result_set{};
+        EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, transaction->execute_query(binder, result_set));
+    }
+
+    for (std::int64_t i = 1; i <= 2; i++) {
+        jogasaki::proto::sql::response::ExecuteResult er{};
+        auto* c = er.mutable_success()->add_counters();
+        c->set_type(jogasaki::proto::sql::response::ExecuteResult::INSERTED_ROWS);
+        c->set_value(1);
+        server_->response_message(er);
+
+        // the values set by the first round are kept in the second except the ones set again
+        EXPECT_EQ(ERROR_CODE::OK, binder.set(0, i * 100));
+        if (i == 1) {
+            EXPECT_EQ(ERROR_CODE::OK, binder.set(1, "text for the test"));
+            EXPECT_EQ(ERROR_CODE::OK, binder.set(2, takatori::decimal::triple{-1, 0, 314, -2}));
+        } else {
+            EXPECT_EQ(ERROR_CODE::OK, binder.set_null(1));
+        }
+        std::size_t num_rows{};
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_statement(binder, num_rows));
+        EXPECT_EQ(1, num_rows);
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+        auto request = request_opt.value();
+        EXPECT_EQ(request.request_case(), jogasaki::proto::sql::request::Request::RequestCase::kExecutePreparedStatement);
+        auto& eps_request = request.execute_prepared_statement();
+        EXPECT_EQ(eps_request.transaction_handle().handle(), 0x12345678);
+        EXPECT_EQ(eps_request.prepared_statement_handle().handle(), 1234);
+        EXPECT_EQ(eps_request.parameters_size(), 3);
+        EXPECT_EQ(eps_request.parameters(0).name(), "int64_data");
+        EXPECT_EQ(eps_request.parameters(0).int8_value(), i * 100);
+        EXPECT_EQ(eps_request.parameters(1).name(), "text_data");
+        if (i == 1) {
+            EXPECT_EQ(eps_request.parameters(1).character_value(), "text for the test");
+        } else {
+            EXPECT_EQ(eps_request.parameters(1).value_case(), ::jogasaki::proto::sql::request::Parameter::ValueCase::VALUE_NOT_SET);
+        }
+        EXPECT_EQ(eps_request.parameters(2).name(), "decimal_data");
+        auto& dec = eps_request.parameters(2).decimal_value();
+        auto triple = jogasaki::utils::read_decimal(dec.unscaled_value(), -dec.exponent());
+        EXPECT_EQ(triple.sign(), -1);
+        EXPECT_EQ(triple.coefficient_low(), 314);
+        EXPECT_EQ(triple.exponent(), -2);
+    }
+
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(PreparedTest, execute_batch) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    PreparedStatementPtr prepared_statement;
+    PreparedStatementPtr prepared_query;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    for (bool has_result_records : { false, true }) {
+        jogasaki::proto::sql::response::Prepare rp{};
+        auto ps = rp.mutable_prepared_statement_handle();
+        ps->set_handle(has_result_records ? 4321 : 1234);
+        ps->set_has_result_records(has_result_records);
+        server_->response_message(rp);
+
+        ogawayama::stub::placeholders_type placeholders{};
+        placeholders.emplace_back("int64_data", ogawayama::stub::Metadata::ColumnType::Type::INT64);
+        placeholders.emplace_back("text_data", ogawayama::stub::Metadata::ColumnType::Type::TEXT);
+        if (has_result_records) {
+            EXPECT_EQ(ERROR_CODE::OK, connection->prepare("select * from table where c1 = :int64_data and c2 = :text_data", placeholders, prepared_query));
+        } else {
+            EXPECT_EQ(ERROR_CODE::OK, connection->prepare("insert into table (c1, c2) values(:int64_data, :text_data)", placeholders, prepared_statement));
+        }
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+    }
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+    }
+
+    // the parameter sets far more than the request wire takes at once
+    constexpr std::size_t number_of_sets = 1000;
+    std::vector<ogawayama::stub::parameters_type> parameter_sets{};
+    for (std::size_t i = 0; i < number_of_sets; i++) {
+        auto& parameters = parameter_sets.emplace_back();
+        parameters.emplace_back("int64_data", static_cast<std::int64_t>(i));
+        parameters.emplace_back("text_data", std::string("text for the test of the batch execution ") + std::to_string(i));
+    }
+
+    jogasaki::proto::sql::response::ExecuteResult er{};
+    auto* c = er.mutable_success()->add_counters();
+    c->set_type(jogasaki::proto::sql::response::ExecuteResult::INSERTED_ROWS);
+    c->set_value(1);
+
+    // count the batch requests, each of which is answered by the default response
+    std::size_t number_of_requests{};
+    server_->default_response(er);
+    EXPECT_EQ(ERROR_CODE::OK, transaction->execute_batch(prepared_statement, parameter_sets, number_of_requests));
+    server_->clear_default_response();
+    EXPECT_GT(number_of_requests, 1);
+
+    for (std::size_t i = 0; i < number_of_requests; i++) {
+        server_->response_message(er);
+    }
+    std::size_t num_rows{};
+    EXPECT_EQ(ERROR_CODE::OK, transaction->execute_batch(prepared_statement, parameter_sets, num_rows));
+    EXPECT_EQ(number_of_requests, num_rows);
+
+    std::size_t index{};
+    for (std::size_t i = 0; i < number_of_requests; i++) {
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        ASSERT_TRUE(request_opt);
+        auto request = request_opt.value();
+        EXPECT_EQ(request.request_case(), jogasaki::proto::sql::request::Request::RequestCase::kBatch);
+        EXPECT_LE(request.ByteSizeLong(), 4096);
+        auto& batch_request = request.batch();
+        EXPECT_EQ(batch_request.transaction_handle().handle(), 0x12345678);
+        EXPECT_EQ(batch_request.prepared_statement_handle().handle(), 1234);
+        for (auto& parameter_set : batch_request.parameter_sets()) {
+            ASSERT_EQ(parameter_set.elements_size(), 2);
+            EXPECT_EQ(parameter_set.elements(0).name(), "int64_data");
+            EXPECT_EQ(parameter_set.elements(0).int8_value(), index);
+            EXPECT_EQ(parameter_set.elements(1).name(), "text_data");
+            EXPECT_EQ(parameter_set.elements(1).character_value(), std::get<std::string>(parameter_sets.at(index).at(1).second));
+            index++;
+        }
+    }
+    EXPECT_EQ(number_of_sets, index);
+
+    // a parameter set larger than the request wire is sent alone, between the requests of the others
+    {
+        std::vector<ogawayama::stub::parameters_type> mixed_sets{};
+        for (std::size_t i = 0; i < 3; i++) {
+            auto& parameters = mixed_sets.emplace_back();
+            parameters.emplace_back("int64_data", static_cast<std::int64_t>(i));
+            parameters.emplace_back("text_data", std::string(i == 1 ? 3 * 4096 : 16, static_cast<char>('a' + i)));
+        }
+        for (std::size_t i = 0; i < 3; i++) {
+            server_->response_message(er);
+        }
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_batch(prepared_statement, mixed_sets, num_rows));
+        EXPECT_EQ(3, num_rows);
+        for (std::size_t i = 0; i < 3; i++) {
+            std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+            ASSERT_TRUE(request_opt);
+            auto& batch_request = request_opt.value().batch();
+            ASSERT_EQ(batch_request.parameter_sets_size(), 1);
+            EXPECT_EQ(batch_request.parameter_sets(0).elements(0).int8_value(), i);
+            EXPECT_EQ(batch_request.parameter_sets(0).elements(1).character_value(), std::get<std::string>(mixed_sets.at(i).at(1).second));
+        }
+    }
+
+    EXPECT_EQ(ERROR_CODE::OK, transaction->execute_batch(prepared_statement, {}, num_rows));
+    EXPECT_EQ(0, num_rows);
+    EXPECT_EQ(ERROR_CODE::INVALID_PARAMETER, transaction->execute_batch(prepared_query, parameter_sets, num_rows));
+
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
+TEST_F(PreparedTest, execute_load) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    StubPtr stub;
+    ConnectionPtr connection;
+    PreparedStatementPtr prepared_statement;
+    TransactionPtr transaction;
+
+    EXPECT_EQ(ERROR_CODE::OK, make_stub(stub, shm_name_));
+
+    EXPECT_EQ(ERROR_CODE::OK, stub->get_connection(connection, 16));
+
+    {
+        jogasaki::proto::sql::response::Prepare rp{};
+        auto ps = rp.mutable_prepared_statement_handle();
+        ps->set_handle(1234);
+        ps->set_has_result_records(false);
+        server_->response_message(rp);
+
+        ogawayama::stub::placeholders_type placeholders{};
+        placeholders.emplace_back("int64_data", ogawayama::stub::Metadata::ColumnType::Type::INT64);
+        placeholders.emplace_back("text_data", ogawayama::stub::Metadata::ColumnType::Type::TEXT);
+        EXPECT_EQ(ERROR_CODE::OK, connection->prepare("insert into table (c1, c2) values(:int64_data, :text_data)", placeholders, prepared_statement));
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+    }
+
+    {
+        jogasaki::proto::sql::response::Begin b{};
+        auto* s = b.mutable_success();
+        s->mutable_transaction_handle()->set_handle(0x12345678);
+        s->mutable_transaction_id()->set_id("transaction_id_for_test");
+        server_->response_message(b);
+        EXPECT_EQ(ERROR_CODE::OK, connection->begin(transaction));
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+    }
+
+    std::vector<std::string> files{ "/tmp/load/0.parquet", "/tmp/load/1.parquet" };
+    ogawayama::stub::column_mapping_type column_mapping{};
+    column_mapping.emplace_back("int64_data", static_cast<std::size_t>(0));
+    column_mapping.emplace_back("text_data", std::string("c2"));
+
+    {
+        jogasaki::proto::sql::response::ExecuteResult er{};
+        auto* c = er.mutable_success()->add_counters();
+        c->set_type(jogasaki::proto::sql::response::ExecuteResult::INSERTED_ROWS);
+        c->set_value(300);
+        server_->response_message(er);
+
+        std::size_t num_rows{};
+        EXPECT_EQ(ERROR_CODE::OK, transaction->execute_load(prepared_statement, files, column_mapping, num_rows));
+        EXPECT_EQ(300, num_rows);
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        ASSERT_TRUE(request_opt);
+        auto& request = request_opt.value();
+        EXPECT_EQ(request.request_case(), jogasaki::proto::sql::request::Request::RequestCase::kExecuteLoad);
+        auto& load_request = request.execute_load();
+        EXPECT_EQ(load_request.transaction_handle().handle(), 0x12345678);
+        EXPECT_EQ(load_request.prepared_statement_handle().handle(), 1234);
+        ASSERT_EQ(load_request.parameters_size(), 2);
+        EXPECT_EQ(load_request.parameters(0).name(), "int64_data");
+        EXPECT_EQ(load_request.parameters(0).value_case(), jogasaki::proto::sql::request::Parameter::ValueCase::kReferenceColumnPosition);
+        EXPECT_EQ(load_request.parameters(0).reference_column_position(), 0);
+        EXPECT_EQ(load_request.parameters(1).name(), "text_data");
+        EXPECT_EQ(load_request.parameters(1).value_case(), jogasaki::proto::sql::request::Parameter::ValueCase::kReferenceColumnName);
+        EXPECT_EQ(load_request.parameters(1).reference_column_name(), "c2");
+        ASSERT_EQ(load_request.file_size(), 2);
+        EXPECT_EQ(load_request.file(0), files.at(0));
+        EXPECT_EQ(load_request.file(1), files.at(1));
+    }
+
+    {
+        // the error can be responded by ResultOnly
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_error()->set_detail("load failed for test");
+        server_->response_message(ro);
+
+        std::size_t num_rows{};
+        EXPECT_EQ(ERROR_CODE::SERVER_ERROR, transaction->execute_load(prepared_statement, files, column_mapping, num_rows));
+        EXPECT_EQ(0, num_rows);
+
+        std::optional<jogasaki::proto::sql::request::Request> request_opt = server_->request_message();
+        EXPECT_TRUE(request_opt);
+    }
+
+    {
+        jogasaki::proto::sql::response::ResultOnly ro{};
+        ro.mutable_success();
+        server_->response_message(ro);
+        server_->response_message(ro);
+        EXPECT_EQ(ERROR_CODE::OK, transaction->commit());
+    }
+}
+
 }  // namespace ogawayama::testing
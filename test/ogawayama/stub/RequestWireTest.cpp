@@ -0,0 +1,87 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "tateyama/transport/client_wire.h"
+
+namespace ogawayama::testing {
+
+static constexpr const char* request_wire_test_name_prefix = "request_wire_test";
+
+class RequestWireTest : public ::testing::Test {
+    void SetUp() override {
+        shm_name_ = std::string(request_wire_test_name_prefix);
+        shm_name_ += std::to_string(getpid());
+        boost::interprocess::shared_memory_object::remove(shm_name_.c_str());
+        managed_shm_ = std::make_unique<boost::interprocess::managed_shared_memory>(boost::interprocess::create_only, shm_name_.c_str(), shm_size);
+    }
+    void TearDown() override {
+        managed_shm_ = nullptr;
+        boost::interprocess::shared_memory_object::remove(shm_name_.c_str());
+    }
+protected:
+    static constexpr std::size_t shm_size = 1024 * 1024;
+    static constexpr std::size_t buffer_size = 4 * 1024;
+
+    std::string shm_name_{};  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,misc-non-private-member-variables-in-classes)
+    std::unique_ptr<boost::interprocess::managed_shared_memory> managed_shm_{};  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes,misc-non-private-member-variables-in-classes)
+};
+
+TEST_F(RequestWireTest, over_capacity_then_normal) {  // NOLINT(google-readability-avoid-underscore-in-googletest-name)
+    static constexpr std::size_t normal_requests = 64;  // longer than the wire in total
+
+    auto* wire = managed_shm_->construct<tateyama::common::wire::unidirectional_message_wire>("request")(managed_shm_.get(), buffer_size);
+    auto* bip_buffer = wire->get_bip_address(managed_shm_.get());
+    tateyama::common::wire::session_wire_container::request_wire_container container(wire, bip_buffer);
+
+    auto request_of = [](std::size_t i) {
+        if (i == 0) {
+            return std::string(buffer_size * 3 + 100, 'Z');
+        }
+        return std::string(200 + (i % 13), static_cast<char>('A' + (i % 26)));
+    };
+
+    std::thread server([wire, bip_buffer, &request_of](){
+        for (std::size_t i = 0; i <= normal_requests; i++) {
+            auto header = wire->peep(bip_buffer);
+            std::string request(header.get_length(), '\0');
+            wire->read(request.data(), bip_buffer);
+            if (request != request_of(i) || header.get_idx() != i) {
+                ADD_FAILURE() << "request " << i << " is corrupted";
+            }
+            if (i == 0) {
+                // let the client catch up with the server while the wire is full
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+        }
+    });
+
+    for (std::size_t i = 0; i <= normal_requests; i++) {
+        auto request = request_of(i);
+        container.write(request.length(), [&request](char* top){ std::memcpy(top, request.data(), request.length()); }, static_cast<tateyama::common::wire::message_header::index_type>(i));
+    }
+    server.join();
+}
+
+}  // namespace ogawayama::testing
@@ -21,6 +21,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <array>
+#include <optional>
 
 #include <boost/archive/binary_oarchive.hpp>
 #include <nlohmann/json.hpp>
@@ -39,6 +40,7 @@
 #include "tateyama/framework/component_ids.h"
 #include "server_wires_impl.h"
 #include "endpoint_proto_utils.h"
+#include "synthetic_resultset.h"
 #include "tateyama/authentication/crypto/rsa.h"
 #include "tateyama/authentication/crypto/base64.h"
 #include "tateyama/authentication/crypto/key.h"
@@ -60,7 +62,8 @@ public:
         BODY_ONLY = 1,
         WITH_BODYHEAD = 2,
         BODYHEAD = 3,
-        FRAMEWORK_ERROR = 4
+        FRAMEWORK_ERROR = 4,
+        WITH_SYNTHETIC_RESULTSET = 5
     };
     endpoint_response() {
         type_ = UNDEFINED;
@@ -76,6 +79,13 @@ public:
         body_ = body;
         type_ = WITH_BODYHEAD;
     }
+    endpoint_response(std::string body_head, std::string_view name, synthetic_resultset& resultset, std::string body) {
+        body_head_ = body_head;
+        name_ = name;
+        synthetic_resultset_ = &resultset;
+        body_ = body;
+        type_ = WITH_SYNTHETIC_RESULTSET;
+    }
     endpoint_response(std::string body_head, std::string_view name) {
         body_head_ = body_head;
         name_ = name;
@@ -90,6 +100,9 @@ public:
     std::queue<std::string>& get_resultset() const {
         return *resultset_;
     }
+    synthetic_resultset& get_synthetic_resultset() const {
+        return *synthetic_resultset_;
+    }
     std::string_view get_name() const {
         return name_;
     }
@@ -101,6 +114,7 @@ private:
     std::string body_head_{};
     std::string name_{};
     std::queue<std::string>* resultset_{};
+    synthetic_resultset* synthetic_resultset_{};
     type type_{};
 };
 
@@ -238,9 +252,7 @@ public:
                 }
 
                 // handle SQL
-                endpoint_->requests_.push(message);
-                auto reply = endpoint_->responses_.front();
-                endpoint_->responses_.pop();
+                auto reply = endpoint_->next_response(message);
                 if (reply.get_type() == endpoint_response::BODY_ONLY) {
                     auto reply_message = reply.get_body();
                     wire_->get_response_wire().write(reply_message.data(), tateyama::common::wire::response_header(index, reply_message.length(), RESPONSE_BODY));
@@ -263,6 +275,28 @@ public:
                     }
                     resultset_wires->set_eor();
 
+                    // body
+                    auto reply_message = reply.get_body();
+                    wire_->get_response_wire().write(reply_message.data(), tateyama::common::wire::response_header(index, reply_message.length(), RESPONSE_BODY));
+                } else if (reply.get_type() == endpoint_response::WITH_SYNTHETIC_RESULTSET) {
+                    resultset_wires_array_.at(index) = wire_->create_resultset_wires(reply.get_name());
+                    auto& resultset_wires = resultset_wires_array_.at(index);
+                    resultset_wire_array_.at(index) = resultset_wires->acquire();
+                    auto& resultset_wire = resultset_wire_array_.at(index);
+                    // body_head
+                    auto body_head = reply.get_body_head();
+                    wire_->get_response_wire().write(body_head.data(), tateyama::common::wire::response_header(index, body_head.length(), RESPONSE_BODYHEAD));
+
+                    // resultset, streamed as the client reads it
+                    auto &resultset = reply.get_synthetic_resultset();
+                    std::string_view row{};
+                    while (resultset.next(row)) {
+                        if (resultset_wire->write_waiting(row.data(), row.length())) {
+                            break;
+                        }
+                    }
+                    resultset_wires->set_eor();
+
                     // body
                     auto reply_message = reply.get_body();
                     wire_->get_response_wire().write(reply_message.data(), tateyama::common::wire::response_header(index, reply_message.length(), RESPONSE_BODY));
@@ -394,6 +428,44 @@ public:
         }
         responses_.emplace(endpoint_response(ss_head.str(), name, resultset, ss_body.str()));
     }
+    void response_message(const jogasaki::proto::sql::response::Response& head, std::string_view name, synthetic_resultset& resultset, const jogasaki::proto::sql::response::Response& body) {
+        std::stringstream ss_head{};
+        ::tateyama::proto::framework::response::Header header{};
+        header.set_payload_type(tateyama::proto::framework::response::Header_PayloadType::Header_PayloadType_SERVICE_RESULT);
+        if(auto res = tateyama::utils::SerializeDelimitedToOstream(header, std::addressof(ss_head)); ! res) {
+            throw std::runtime_error("error formatting response message");
+        }
+        if(auto res = tateyama::utils::SerializeDelimitedToOstream(head, std::addressof(ss_head)); ! res) {
+            throw std::runtime_error("error formatting response message");
+        }
+
+        std::stringstream ss_body{};
+        if(auto res = tateyama::utils::SerializeDelimitedToOstream(header, std::addressof(ss_body)); ! res) {
+            throw std::runtime_error("error formatting response message");
+        }
+        if(auto res = tateyama::utils::SerializeDelimitedToOstream(body, std::addressof(ss_body)); ! res) {
+            throw std::runtime_error("error formatting response message");
+        }
+        responses_.emplace(endpoint_response(ss_head.str(), name, resultset, ss_body.str()));
+    }
+    // the response to every SQL request while no response is queued, the requests are not recorded then
+    void default_response_message(const jogasaki::proto::sql::response::Response& message) {
+        std::stringstream ss{};
+        ::tateyama::proto::framework::response::Header header{};
+        header.set_payload_type(tateyama::proto::framework::response::Header_PayloadType::Header_PayloadType_SERVICE_RESULT);
+        if(auto res = tateyama::utils::SerializeDelimitedToOstream(header, std::addressof(ss)); ! res) {
+            throw std::runtime_error("error formatting response message");
+        }
+        if(auto res = tateyama::utils::SerializeDelimitedToOstream(message, std::addressof(ss)); ! res) {
+            throw std::runtime_error("error formatting response message");
+        }
+        std::lock_guard<std::mutex> lock(mtx_default_response_);
+        default_response_ = endpoint_response(ss.str());
+    }
+    void clear_default_response() {
+        std::lock_guard<std::mutex> lock(mtx_default_response_);
+        default_response_ = std::nullopt;
+    }
     void response_body_head(const jogasaki::proto::sql::response::Response& head, std::string_view name) {
         std::stringstream ss_head{};
         ::tateyama::proto::framework::response::Header header{};
@@ -438,9 +510,24 @@ private:
 
     std::queue<std::string> requests_{};
     std::queue<endpoint_response> responses_{};
+    std::optional<endpoint_response> default_response_{};
+    std::mutex mtx_default_response_{};
     std::string current_request_{};
     ::tateyama::proto::framework::response::Header framework_header_{};
 
+    endpoint_response next_response(const std::string& message) {
+        if (responses_.empty()) {
+            std::lock_guard<std::mutex> lock(mtx_default_response_);
+            if (default_response_) {
+                return default_response_.value();
+            }
+        }
+        requests_.push(message);
+        auto reply = responses_.front();
+        responses_.pop();
+        return reply;
+    }
+
     friend class worker;
 };
 
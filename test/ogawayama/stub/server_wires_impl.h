@@ -114,6 +114,18 @@ public:
             annex_.insert(write_pos_ + chunk_size_, data, length);
             chunk_size_ += length;
         }
+        /**
+         * @brief write a record waiting for the room in the wire, instead of keeping it in the annex.
+         * @return true if the wire has been closed by the client
+         */
+        bool write_waiting(char const* data, std::size_t length) {
+            if (shm_resultset_wire_->wait_room(length)) {
+                return true;
+            }
+            shm_resultset_wire_->write(data, length);
+            shm_resultset_wire_->flush();
+            return false;
+        }
         void flush() {
             if (!annex_mode_) {
                 shm_resultset_wire_->flush();
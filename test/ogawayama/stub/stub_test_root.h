@@ -80,6 +80,33 @@ public:
         (void) e.release_record_meta();
     }
 
+    void response_with_resultset(synthetic_resultset& resultset, jogasaki::proto::sql::response::ResultOnly& ro) {
+        std::string resultset_name{resultset_name_prefix};
+        resultset_name += std::to_string(resultset_number_++);
+        // body_head
+        jogasaki::proto::sql::response::Response rh{};
+        auto* e = rh.mutable_execute_query();
+        e->set_name(std::string(resultset_name));
+        *e->mutable_record_meta() = resultset.metadata();
+        // body
+        jogasaki::proto::sql::response::Response rb{};
+        rb.set_allocated_result_only(&ro);
+        // set response
+        endpoint_.response_message(rh, resultset_name, resultset, rb);
+        // release
+        (void) rb.release_result_only();
+    }
+
+    void default_response(jogasaki::proto::sql::response::ExecuteResult& er) {
+        jogasaki::proto::sql::response::Response r{};
+        r.set_allocated_execute_result(&er);
+        endpoint_.default_response_message(r);
+        (void) r.release_execute_result();
+    }
+    void clear_default_response() {
+        endpoint_.clear_default_response();
+    }
+
     void response_body_head(jogasaki::proto::sql::response::ResultSetMetadata& metadata) {
         std::string resultset_name{resultset_name_prefix};
         resultset_name += std::to_string(resultset_number_++);
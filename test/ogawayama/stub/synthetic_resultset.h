@@ -0,0 +1,157 @@
+/*
+ * Copyright 2019-2025 Project Tsurugi.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <jogasaki/proto/sql/common.pb.h>
+#include <jogasaki/proto/sql/response.pb.h>
+#include <jogasaki/serializer/value_output.h>
+
+namespace ogawayama::testing {
+
+/**
+ * @brief a column of the synthetic result set.
+ */
+struct synthetic_column {
+    jogasaki::proto::sql::common::AtomType type{jogasaki::proto::sql::common::AtomType::INT8};
+    double null_ratio{};      // the ratio of NULL values, 0 means no NULL
+    std::size_t length{16};   // the length of CHARACTER values
+};
+
+/**
+ * @brief a result set of the given number of rows generated from the column specification.
+ *  A pool of distinct rows is encoded on construction and repeated up to the number of rows,
+ *  so that the server spends as little as possible in streaming them.
+ */
+class synthetic_resultset {
+public:
+    static constexpr std::size_t pool_size = 256;
+
+    synthetic_resultset(std::vector<synthetic_column> columns, std::size_t rows, std::uint32_t seed = 0)
+        : columns_(std::move(columns)), rows_(rows) {
+        std::mt19937 engine{seed};
+        pool_.reserve(pool_size);
+        for (std::size_t i = 0; i < pool_size; i++) {
+            pool_.emplace_back(encode_row(engine));
+        }
+    }
+
+    /**
+     * @brief provide the metadata of the result set.
+     */
+    [[nodiscard]] jogasaki::proto::sql::response::ResultSetMetadata metadata() const {
+        jogasaki::proto::sql::response::ResultSetMetadata metadata{};
+        for (auto&& column : columns_) {
+            metadata.add_columns()->set_atom_type(column.type);
+        }
+        return metadata;
+    }
+    /**
+     * @brief provide the next row encoded.
+     * @return false if all the rows have been provided
+     */
+    bool next(std::string_view& row) {
+        if (position_ >= rows_) {
+            return false;
+        }
+        row = pool_.at(position_++ % pool_size);
+        return true;
+    }
+    /**
+     * @brief provide the rows again from the first one.
+     */
+    void rewind() noexcept {
+        position_ = 0;
+    }
+    [[nodiscard]] std::size_t rows() const noexcept {
+        return rows_;
+    }
+    [[nodiscard]] std::size_t columns() const noexcept {
+        return columns_.size();
+    }
+
+private:
+    std::vector<synthetic_column> columns_;
+    std::size_t rows_;
+    std::size_t position_{};
+    std::vector<std::string> pool_{};
+
+    std::string encode_row(std::mt19937& engine) {
+        static constexpr std::size_t fixed_length = 32;  // enough for every type but CHARACTER
+
+        std::size_t capacity = fixed_length;
+        for (auto&& column : columns_) {
+            capacity += fixed_length + column.length;
+        }
+        std::string row(capacity, '\0');
+        takatori::util::buffer_view buf{row.data(), row.size()};
+        auto iter = buf.begin();
+        auto end = buf.end();
+        std::uniform_real_distribution<double> ratio{0.0, 1.0};
+
+        jogasaki::serializer::write_row_begin(columns_.size(), iter, end);
+        for (auto&& column : columns_) {
+            if (column.null_ratio > 0.0 && ratio(engine) < column.null_ratio) {
+                jogasaki::serializer::write_null(iter, end);
+                continue;
+            }
+            auto value = static_cast<std::int64_t>(engine());
+            switch (column.type) {
+            case jogasaki::proto::sql::common::AtomType::INT4:
+                jogasaki::serializer::write_int(static_cast<std::int32_t>(value), iter, end);
+                break;
+            case jogasaki::proto::sql::common::AtomType::INT8:
+                jogasaki::serializer::write_int(value * value, iter, end);
+                break;
+            case jogasaki::proto::sql::common::AtomType::FLOAT4:
+                jogasaki::serializer::write_float4(static_cast<float>(value) / 3.0F, iter, end);
+                break;
+            case jogasaki::proto::sql::common::AtomType::FLOAT8:
+                jogasaki::serializer::write_float8(static_cast<double>(value) / 3.0, iter, end);
+                break;
+            case jogasaki::proto::sql::common::AtomType::CHARACTER:
+                jogasaki::serializer::write_character(std::string(column.length, static_cast<char>('A' + (value % 26))), iter, end);
+                break;
+            case jogasaki::proto::sql::common::AtomType::DECIMAL:
+                // half of them do not fit in 64 bits, to be written as decimal rather than int
+                jogasaki::serializer::write_decimal(takatori::decimal::triple{1, static_cast<std::uint64_t>(value % 2), static_cast<std::uint64_t>(value), -2}, iter, end);
+                break;
+            case jogasaki::proto::sql::common::AtomType::DATE:
+                jogasaki::serializer::write_date(takatori::datetime::date{value % 36500}, iter, end);
+                break;
+            case jogasaki::proto::sql::common::AtomType::TIME_OF_DAY:
+                jogasaki::serializer::write_time_of_day(takatori::datetime::time_of_day{std::chrono::seconds{value % 86400}}, iter, end);
+                break;
+            case jogasaki::proto::sql::common::AtomType::TIME_POINT:
+                jogasaki::serializer::write_time_point(takatori::datetime::time_point{std::chrono::seconds{value}}, iter, end);
+                break;
+            default:
+                throw std::runtime_error("the type is not supported by the synthetic result set");
+            }
+        }
+        jogasaki::serializer::write_end_of_contents(iter, end);
+        row.resize(std::distance(buf.begin(), iter));
+        return row;
+    }
+};
+
+}  // namespace ogawayama::testing